@@ -0,0 +1,799 @@
+///  Contains the benchmark suite of the graph algorithms and the game of hex
+#include "CompactGraph.h"
+#include "DeltaStepping.h"
+#include "GraphLoader.h"
+#include "MinimumSpanningTree.h"
+#include "RandomGraph.h"
+#include "Hex.h"
+#include "Tournament.h"
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <sstream>
+
+using std::function;
+using std::istringstream;
+using std::ofstream;
+using std::chrono::duration;
+
+//  Settings of a run. Every one of them can be changed from the command line
+class BenchmarkOptions
+{
+public:
+	vector<unsigned int> m_GraphSizes;
+	vector<unsigned int> m_BoardSizes;
+	double m_Density;
+	//  Every operation is repeated until this time in seconds is spent
+	double m_MinTime;
+	//  Time budget of a move of the search players in milliseconds
+	unsigned int m_MoveTime;
+	unsigned int m_TurnBoardSize;
+	//  Only the operations whose names contain the filter are measured
+	string m_Filter;
+	string m_Output;
+	string m_GraphFile;
+
+	BenchmarkOptions();
+	//  Returns false if the command line is wrong
+	bool Parse(int argc, char *argv[]);
+};
+
+//  One measured operation. size is the number of vertices of a graph or the side of a hex board
+class BenchmarkResult
+{
+public:
+	string m_Name;
+	unsigned int m_Size;
+	unsigned long long m_Operations;
+	double m_Seconds;
+};
+
+//  This class runs all the benchmarks and outputs their results as JSON, so results of different commits can be diffed.
+//  Graphs are generated with a fixed seed, so every run measures the same graphs
+class HexBenchmark
+{
+private:
+	BenchmarkOptions m_Options;
+	vector<BenchmarkResult> m_Results;
+	std::mt19937 m_Random;
+	//  Results of the measured calls are added here, so the compiler can't throw the calls away
+	double m_Sink;
+
+	bool IsSelected(const string &name) const;
+	//  Call the function repeatedly (after one warm-up call) until m_MinTime is spent.
+	//  Every call makes the given number of operations
+	void Measure(const string &name, unsigned int size, unsigned int operations, const function<void()> &call);
+	//  1, 2, 4... threads up to the number of the hardware cores, the last one is the number of the cores
+	static vector<unsigned int> GetThreadCounts();
+	//  Call the function once without a warm-up. It is used for expensive operations like a turn of a player
+	void MeasureOnce(const string &name, unsigned int size, const function<void()> &call);
+
+	void RunGraph(unsigned int size);
+	void RunPriorityQueue(unsigned int size);
+	void RunShortestPath(unsigned int size);
+	void RunHex(unsigned int size, HexBoardType boardType);
+	void RunTurns(unsigned int size);
+	//  Fill the board with random moves until half of it is taken or the game is over
+	void MakeRandomPosition(Hex &hexBoard);
+public:
+	explicit HexBenchmark(const BenchmarkOptions &options);
+	~HexBenchmark();
+
+	void Run();
+	void WriteJson(ostream &os) const;
+};
+
+BenchmarkOptions::BenchmarkOptions() : m_Density(0.1), m_MinTime(0.2), m_MoveTime(100), m_TurnBoardSize(7),
+	m_GraphFile("hex_benchmark_graph.txt")
+{
+	m_GraphSizes.push_back(50);
+	m_GraphSizes.push_back(100);
+	m_GraphSizes.push_back(200);
+	m_BoardSizes.push_back(5);
+	m_BoardSizes.push_back(7);
+	m_BoardSizes.push_back(11);
+}
+
+//  Parse a comma separated list of positive numbers
+static bool ParseSizes(const string &text, vector<unsigned int> &sizes)
+{
+	istringstream is(text);
+	string item;
+
+	sizes.clear();
+	while (getline(is, item, ','))
+	{
+		if (item.empty() || item.find_first_not_of("0123456789") != string::npos || stoul(item) == 0)
+			return false;
+		sizes.push_back(stoul(item));
+	}
+
+	return !sizes.empty();
+}
+
+bool BenchmarkOptions::Parse(int argc, char *argv[])
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		string option = argv[i];
+
+		if (option == "--quick")
+		{
+			m_GraphSizes.assign(1, 50);
+			m_BoardSizes.assign(1, 5);
+			m_MinTime = 0.01;
+			m_MoveTime = 10;
+			m_TurnBoardSize = 4;
+			continue;
+		}
+
+		if (i + 1 >= argc)
+			return false;
+		string value = argv[++i];
+
+		if (option == "--graph-sizes")
+		{
+			if (!ParseSizes(value, m_GraphSizes))
+				return false;
+		}
+		else if (option == "--board-sizes")
+		{
+			if (!ParseSizes(value, m_BoardSizes))
+				return false;
+			for (auto it = m_BoardSizes.begin(); it != m_BoardSizes.end(); ++it)
+				if (*it < 2)
+					return false;
+		}
+		else if (option == "--density")
+			m_Density = atof(value.c_str());
+		else if (option == "--min-time")
+			m_MinTime = atof(value.c_str());
+		else if (option == "--move-time")
+			m_MoveTime = atoi(value.c_str());
+		else if (option == "--turn-board-size")
+			m_TurnBoardSize = atoi(value.c_str());
+		else if (option == "--filter")
+			m_Filter = value;
+		else if (option == "--output")
+			m_Output = value;
+		else if (option == "--graph-file")
+			m_GraphFile = value;
+		else
+			return false;
+	}
+
+	return m_Density > 0.0 && m_Density <= 1.0 && m_MinTime >= 0.0 && m_TurnBoardSize >= 2;
+}
+
+HexBenchmark::HexBenchmark(const BenchmarkOptions &options) : m_Options(options), m_Random(12345), m_Sink(0.0)
+{
+}
+
+HexBenchmark::~HexBenchmark()
+{
+}
+
+bool HexBenchmark::IsSelected(const string &name) const
+{
+	return m_Options.m_Filter.empty() || name.find(m_Options.m_Filter) != string::npos;
+}
+
+void HexBenchmark::Measure(const string &name, unsigned int size, unsigned int operations, const function<void()> &call)
+{
+	if (!IsSelected(name))
+		return;
+
+	BenchmarkResult result;
+	result.m_Name = name;
+	result.m_Size = size;
+	result.m_Operations = 0;
+	result.m_Seconds = 0.0;
+
+	call();
+	steady_clock::time_point start = steady_clock::now();
+	do
+	{
+		call();
+		result.m_Operations += operations;
+		result.m_Seconds = duration<double>(steady_clock::now() - start).count();
+	} while (result.m_Seconds < m_Options.m_MinTime);
+
+	m_Results.push_back(result);
+}
+
+void HexBenchmark::MeasureOnce(const string &name, unsigned int size, const function<void()> &call)
+{
+	if (!IsSelected(name))
+		return;
+
+	BenchmarkResult result;
+	result.m_Name = name;
+	result.m_Size = size;
+	result.m_Operations = 1;
+
+	steady_clock::time_point start = steady_clock::now();
+	call();
+	result.m_Seconds = duration<double>(steady_clock::now() - start).count();
+
+	m_Results.push_back(result);
+}
+
+vector<unsigned int> HexBenchmark::GetThreadCounts()
+{
+	unsigned int cores = std::max(1u, thread::hardware_concurrency());
+	vector<unsigned int> threadCounts;
+
+	for (unsigned int threads = 1; threads < cores; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(cores);
+
+	return threadCounts;
+}
+
+void HexBenchmark::RunGraph(unsigned int size)
+{
+	const unsigned int queries = 1000;
+
+	srand(size);
+	Graph graph(size, m_Options.m_Density, 1.0, 10.0);
+
+	Measure("Graph/RandomConstruction", size, 1, [&]()
+	{
+		Graph g(size, m_Options.m_Density, 1.0, 10.0);
+		m_Sink += g.GetEdgesAmount();
+	});
+
+	//  The generator without the lists of the Graph, the work is proportional to the number of the edges
+	vector<unsigned int> threadCounts = GetThreadCounts();
+	for (auto it = threadCounts.begin(); it != threadCounts.end(); ++it)
+	{
+		RandomGraphGenerator generator(size, *it);
+		std::ostringstream name;
+		name << "RandomGraph/GenerateCompactGraph/Threads" << *it;
+		Measure(name.str(), size, 1, [&]()
+		{
+			m_Sink += generator.GenerateCompactGraph(size, m_Options.m_Density, 1.0, 10.0).GetEdgesAmount();
+		});
+	}
+
+	//  100 times more vertices with the average degree of 10
+	Measure("RandomGraph/GenerateCompactGraph/Sparse", size, 1, [&]()
+	{
+		RandomGraphGenerator generator(size);
+		m_Sink += generator.GenerateCompactGraph(100 * size, 10.0 / (100 * size), 1.0, 10.0).GetEdgesAmount();
+	});
+
+	//  The file has the format of Graph(filename): the number of vertices and then "v1 v2 length" lines.
+	//  It is written if any of the benchmarks that read it is selected
+	bool fileSelected = IsSelected("Graph/FileConstruction") || IsSelected("GraphLoader/GetCompactGraph");
+	for (auto it = threadCounts.begin(); it != threadCounts.end(); ++it)
+	{
+		std::ostringstream name;
+		name << "GraphLoader/Load/Threads" << *it;
+		fileSelected = fileSelected || IsSelected(name.str());
+	}
+
+	if (fileSelected)
+	{
+		ofstream fout(m_Options.m_GraphFile);
+		fout << size << "\n";
+		for (unsigned int v = 0; v < size; ++v)
+		{
+			const list<Edge> &edges = graph.GetNodeEdges(v);
+			for (auto it = edges.begin(); it != edges.end(); ++it)
+				fout << v << " " << it->GetEndVertexNumber() << " " << static_cast<int>(it->GetEdgeWeight()) << "\n";
+		}
+		fout.close();
+
+		Measure("Graph/FileConstruction", size, 1, [&]()
+		{
+			Graph g(m_Options.m_GraphFile);
+			m_Sink += g.GetEdgesAmount();
+		});
+
+		//  Operations are the bytes of the file, so 1000 / ns_per_op is the loading speed in MB/s
+		GraphLoader loader;
+		bool loaded = loader.Load(m_Options.m_GraphFile);
+		if (!loaded)
+			std::cerr << m_Options.m_GraphFile << ": " << loader.GetError() << "\n";
+		unsigned int bytes = static_cast<unsigned int>(loader.GetBytes());
+		for (auto it = threadCounts.begin(); it != threadCounts.end() && loaded; ++it)
+		{
+			unsigned int threads = *it;
+			std::ostringstream name;
+			name << "GraphLoader/Load/Threads" << threads;
+			Measure(name.str(), size, bytes, [&]()
+			{
+				GraphLoader threadsLoader(threads);
+				threadsLoader.Load(m_Options.m_GraphFile);
+				m_Sink += threadsLoader.GetEdgesAmount();
+			});
+		}
+
+		if (loaded)
+			Measure("GraphLoader/GetCompactGraph", size, 1, [&]()
+			{
+				m_Sink += loader.GetCompactGraph().GetEdgesAmount();
+			});
+		remove(m_Options.m_GraphFile.c_str());
+	}
+
+	Measure("Graph/Adjacent", size, queries, [&]()
+	{
+		unsigned int adjacent = 0;
+		for (unsigned int i = 0; i < queries; ++i)
+			if (graph.Adjacent(m_Random() % size, m_Random() % size))
+				adjacent++;
+		m_Sink += adjacent;
+	});
+
+	Measure("Graph/AddEdge", size, 4 * size, [&]()
+	{
+		Graph g(size);
+		for (unsigned int i = 0; i < 4 * size; ++i)
+			g.AddEdge(m_Random() % size, m_Random() % size, 1.0);
+		m_Sink += g.GetEdgesAmount();
+	});
+
+	Measure("Graph/PrimMST", size, 1, [&]()
+	{
+		double length = 0.0;
+		Graph tree = graph.PrimMST(length);
+		m_Sink += length;
+	});
+
+	MinimumSpanningTreeAlgorithm spanningTree;
+	Measure("Graph/KruskalMST", size, 1, [&]()
+	{
+		double length = 0.0;
+		Graph tree = spanningTree.KruskalMST(graph, length);
+		m_Sink += length;
+	});
+
+	Measure("Graph/GetConnections", size, 1, [&]()
+	{
+		m_Sink += graph.GetConnections(m_Random() % size).size();
+	});
+
+	CompactGraph compact(graph);
+
+	Measure("CompactGraph/Freeze", size, 1, [&]()
+	{
+		CompactGraph g(graph);
+		m_Sink += g.GetEdgesAmount();
+	});
+
+	Measure("CompactGraph/PrimMST", size, 1, [&]()
+	{
+		double length = 0.0;
+		Graph tree = compact.PrimMST(length);
+		m_Sink += length;
+	});
+
+	Measure("CompactGraph/KruskalMST", size, 1, [&]()
+	{
+		double length = 0.0;
+		Graph tree = spanningTree.KruskalMST(compact, length);
+		m_Sink += length;
+	});
+
+	//  The spanning forest on the threads, compare it with CompactGraph/PrimMST and CompactGraph/KruskalMST
+	for (auto it = threadCounts.begin(); it != threadCounts.end(); ++it)
+	{
+		MinimumSpanningTreeAlgorithm spanningForest(*it);
+		std::ostringstream name;
+		name << "CompactGraph/BoruvkaMSF/Threads" << *it;
+		Measure(name.str(), size, 1, [&]()
+		{
+			double length = 0.0;
+			Graph forest = spanningForest.BoruvkaMSF(compact, length);
+			m_Sink += length;
+		});
+	}
+
+	//  100 times more vertices with the average degree of 2, a disconnected graph that has no spanning tree
+	if (IsSelected("CompactGraph/BoruvkaMSF/Sparse"))
+	{
+		RandomGraphGenerator generator(size);
+		CompactGraph sparse = generator.GenerateCompactGraph(100 * size, 2.0 / (100 * size), 1.0, 10.0);
+		MinimumSpanningTreeAlgorithm spanningForest;
+		Measure("CompactGraph/BoruvkaMSF/Sparse", size, 1, [&]()
+		{
+			double length = 0.0;
+			Graph forest = spanningForest.BoruvkaMSF(sparse, length);
+			m_Sink += length + spanningForest.GetComponentLengths().size();
+		});
+	}
+
+	Measure("CompactGraph/GetConnections", size, 1, [&]()
+	{
+		m_Sink += compact.GetConnections(m_Random() % size).size();
+	});
+
+	//  Opening a snapshot maps the file, compare it with GraphLoader/Load of the text file of the same graph
+	//  The file is written before the benchmarks, so the open ones find it when SaveSnapshot is not selected
+	if (IsSelected("CompactGraph/SaveSnapshot") || IsSelected("CompactGraph/OpenSnapshot/GetShortestDistances"))
+	{
+		string snapshotFile = m_Options.m_GraphFile + ".snapshot";
+
+		if (!compact.SaveSnapshot(snapshotFile))
+		{
+			std::cerr << snapshotFile << ": the snapshot can't be written\n";
+			return;
+		}
+
+		Measure("CompactGraph/SaveSnapshot", size, 1, [&]()
+		{
+			m_Sink += compact.SaveSnapshot(snapshotFile) ? 1 : 0;
+		});
+
+		Measure("CompactGraph/OpenSnapshot", size, 1, [&]()
+		{
+			CompactGraph g;
+			if (g.OpenSnapshot(snapshotFile))
+				m_Sink += g.GetEdgesAmount();
+		});
+
+		//  The first search touches the pages of the mapped file
+		Measure("CompactGraph/OpenSnapshot/GetShortestDistances", size, 1, [&]()
+		{
+			CompactGraph g;
+			ShortestPathAlgorithm algorithm;
+			if (g.OpenSnapshot(snapshotFile))
+				m_Sink += algorithm.GetShortestDistances(g, 0).back();
+		});
+		remove(snapshotFile.c_str());
+	}
+}
+
+void HexBenchmark::RunPriorityQueue(unsigned int size)
+{
+	std::uniform_real_distribution<double> priority(0.0, 1.0);
+
+	Measure("PriorityQueue/InsertPop", size, size, [&]()
+	{
+		PriorityQueue<unsigned int, double> queue;
+		for (unsigned int i = 0; i < size; ++i)
+			queue.Insert(i, priority(m_Random));
+		while (!queue.Empty())
+		{
+			m_Sink += queue.GetTopPriority();
+			queue.Pop();
+		}
+	});
+
+	//  Values repeat, so a half of the calls looks for an element that is already in the queue
+	Measure("PriorityQueue/InsertIfPriorityLess", size, 2 * size, [&]()
+	{
+		PriorityQueue<unsigned int, double> queue;
+		for (unsigned int i = 0; i < 2 * size; ++i)
+			queue.InsertIfPriorityLess(m_Random() % size, priority(m_Random));
+		m_Sink += queue.Size();
+	});
+
+	Measure("IndexedPriorityQueue/InsertPop", size, size, [&]()
+	{
+		IndexedPriorityQueue<double> queue(size);
+		for (unsigned int i = 0; i < size; ++i)
+			queue.Insert(i, priority(m_Random));
+		while (!queue.Empty())
+		{
+			m_Sink += queue.GetTopPriority();
+			queue.Pop();
+		}
+	});
+
+	Measure("IndexedPriorityQueue/InsertIfPriorityLess", size, 2 * size, [&]()
+	{
+		IndexedPriorityQueue<double> queue(size);
+		for (unsigned int i = 0; i < 2 * size; ++i)
+			queue.InsertIfPriorityLess(m_Random() % size, priority(m_Random));
+		m_Sink += queue.Size();
+	});
+}
+
+void HexBenchmark::RunShortestPath(unsigned int size)
+{
+	const unsigned int queries = 10;
+	ShortestPathAlgorithm algorithm;
+
+	srand(size);
+	Graph graph(size, m_Options.m_Density, 1.0, 10.0);
+
+	Measure("ShortestPath/GetShortestPath", size, queries, [&]()
+	{
+		for (unsigned int i = 0; i < queries; ++i)
+			m_Sink += algorithm.GetShortestPath(graph, m_Random() % size, m_Random() % size).GetWeight();
+	});
+
+	Measure("ShortestPath/GetShortestPathLength", size, queries, [&]()
+	{
+		for (unsigned int i = 0; i < queries; ++i)
+			m_Sink += algorithm.GetShortestPathLength(graph, m_Random() % size, m_Random() % size);
+	});
+
+	Measure("ShortestPath/AverageShortestPath", size, 1, [&]()
+	{
+		m_Sink += algorithm.AverageShortestPath(graph, m_Random() % size);
+	});
+
+	//  A path through all the vertices of a chain, it is 10 times longer than the graph size
+	Graph chain(10 * size);
+	for (unsigned int v = 0; v + 1 < chain.GetVerticesAmount(); ++v)
+	{
+		chain.AddEdge(v, v + 1, 1.0);
+		chain.AddEdge(v + 1, v, 1.0);
+	}
+
+	Measure("ShortestPath/GetShortestPath/Chain", size, 1, [&]()
+	{
+		m_Sink += algorithm.GetShortestPath(chain, 0, chain.GetVerticesAmount() - 1).GetWeight();
+	});
+
+	Measure("ShortestPath/GetShortestPathLength/Chain", size, 1, [&]()
+	{
+		m_Sink += algorithm.GetShortestPathLength(chain, 0, chain.GetVerticesAmount() - 1);
+	});
+
+	CompactGraph compact(graph);
+
+	Measure("ShortestPath/GetShortestPath/Compact", size, queries, [&]()
+	{
+		for (unsigned int i = 0; i < queries; ++i)
+			m_Sink += algorithm.GetShortestPath(compact, m_Random() % size, m_Random() % size).GetWeight();
+	});
+
+	Measure("ShortestPath/GetShortestPathLength/Compact", size, queries, [&]()
+	{
+		for (unsigned int i = 0; i < queries; ++i)
+			m_Sink += algorithm.GetShortestPathLength(compact, m_Random() % size, m_Random() % size);
+	});
+
+	Measure("ShortestPath/AverageShortestPath/Compact", size, 1, [&]()
+	{
+		m_Sink += algorithm.AverageShortestPath(compact, m_Random() % size);
+	});
+
+	CompactGraph reversed = compact.GetReversed();
+
+	Measure("ShortestPath/GetShortestPathLength/Bidirectional", size, queries, [&]()
+	{
+		for (unsigned int i = 0; i < queries; ++i)
+			m_Sink += algorithm.GetShortestPathLengthBidirectional(compact, reversed, m_Random() % size, m_Random() % size);
+	});
+
+	//  The same graph with the weights rounded to integers from 1 to 10, searched with the heap and with the buckets
+	vector<Edge> integerEdges;
+	for (unsigned int v = 0; v < size; ++v)
+		graph.ForEachEdge(v, [&](unsigned int target, double weight)
+		{
+			integerEdges.push_back(Edge(v, target, floor(weight + 0.5)));
+		});
+	CompactGraph integerGraph(size, integerEdges);
+
+	algorithm.SetIntegerSearch(false);
+	Measure("ShortestPath/GetShortestDistances/IntegerHeap", size, 1, [&]()
+	{
+		m_Sink += algorithm.GetShortestDistances(integerGraph, m_Random() % size).back();
+	});
+	algorithm.SetIntegerSearch(true);
+
+	Measure("ShortestPath/GetShortestDistances/IntegerBuckets", size, 1, [&]()
+	{
+		m_Sink += algorithm.GetShortestDistances(integerGraph, m_Random() % size).back();
+	});
+
+	//  All the distances from a vertex in one search, the analysis jobs called GetShortestPathLength for every target before
+	Measure("ShortestPath/GetShortestDistances", size, 1, [&]()
+	{
+		m_Sink += algorithm.GetShortestDistances(graph, m_Random() % size).back();
+	});
+
+	Measure("ShortestPath/GetShortestDistances/Compact", size, 1, [&]()
+	{
+		m_Sink += algorithm.GetShortestDistances(compact, m_Random() % size).back();
+	});
+
+	//  Averages of all the vertices, the speedup curve of the threads
+	vector<unsigned int> threadCounts = GetThreadCounts();
+	for (auto it = threadCounts.begin(); it != threadCounts.end(); ++it)
+	{
+		unsigned int threads = *it;
+		std::ostringstream name;
+		name << "ShortestPath/GetAverageShortestPaths/Compact/Threads" << threads;
+		Measure(name.str(), size, size, [&]()
+		{
+			m_Sink += ShortestPathAlgorithm::GetMean(ShortestPathAlgorithm::GetAverageShortestPaths(compact, threads));
+		});
+	}
+
+	//  Distances from a vertex with the parallel delta-stepping, compare them with GetShortestDistances/Compact
+	for (auto it = threadCounts.begin(); it != threadCounts.end(); ++it)
+	{
+		DeltaSteppingAlgorithm deltaStepping(*it);
+		std::ostringstream name;
+		name << "ShortestPath/DeltaStepping/Threads" << *it;
+		Measure(name.str(), size, 1, [&]()
+		{
+			m_Sink += deltaStepping.GetShortestDistances(compact, m_Random() % size).back();
+		});
+	}
+
+	//  The same average computed with a GetShortestPathLength call per vertex. The comment of ShortestPathAlgorithm
+	//  says AverageShortestPath is more than 20% faster than this
+	Measure("ShortestPath/AverageByPathLength", size, 1, [&]()
+	{
+		unsigned int u = m_Random() % size, reached = 0;
+		double sum = 0.0;
+		for (unsigned int v = 0; v < size; ++v)
+		{
+			double length = v == u ? -1.0 : algorithm.GetShortestPathLength(graph, u, v);
+			if (length >= 0.0)
+			{
+				sum += length;
+				reached++;
+			}
+		}
+		m_Sink += reached > 0 ? sum / reached : -1.0;
+	});
+}
+
+void HexBenchmark::MakeRandomPosition(Hex &hexBoard)
+{
+	while (hexBoard.m_Empty > hexBoard.m_Size * hexBoard.m_Size / 2 && hexBoard.GetWinner() == NONE)
+	{
+		coordinates coord(m_Random() % hexBoard.m_Size, m_Random() % hexBoard.m_Size);
+		if (hexBoard.GetVertexColor(coord) == NONE)
+			hexBoard.MakeMove(coord);
+	}
+}
+
+void HexBenchmark::RunHex(unsigned int size, HexBoardType boardType)
+{
+	const unsigned int queries = 100;
+	string board = boardType == BIT_BOARD ? "/BitBoard" : "/GraphBoard";
+	Hex hex(size, make_shared<RandomStrategyPlayer>(RED), make_shared<RandomStrategyPlayer>(BLUE), boardType);
+
+	MakeRandomPosition(hex);
+
+	Measure("Hex/GetWinner" + board, size, queries, [&]()
+	{
+		unsigned int winners = 0;
+		for (unsigned int i = 0; i < queries; ++i)
+			if (hex.GetWinner() != NONE)
+				winners++;
+		m_Sink += winners;
+	});
+
+	Measure("Hex/RandomSimulation" + board, size, 1, [&]()
+	{
+		m_Sink += hex.RandomSimulation();
+	});
+
+	//  Point-to-point queries between random hexagons on the board graph with unit weights
+	if (boardType == GRAPH_BOARD)
+	{
+		Graph boardGraph = hex.GetBoardGraph();
+		for (unsigned int v = 0; v < boardGraph.GetVerticesAmount(); ++v)
+		{
+			list<Edge> &edges = boardGraph.GetNodeEdges(v);
+			for (auto it = edges.begin(); it != edges.end(); ++it)
+				it->SetEdgeWeight(1.0);
+		}
+		CompactGraph compact(boardGraph);
+		HexGridHeuristic heuristic(size, 1.0);
+		ShortestPathAlgorithm algorithm;
+
+		algorithm.SetIntegerSearch(false);
+		Measure("Hex/ShortestPath/Dijkstra", size, queries, [&]()
+		{
+			for (unsigned int i = 0; i < queries; ++i)
+				m_Sink += algorithm.GetShortestPathLength(compact, m_Random() % (size * size), m_Random() % (size * size));
+		});
+		algorithm.SetIntegerSearch(true);
+
+		//  The weights are 1, so it is the 0-1 BFS
+		Measure("Hex/ShortestPath/Integer", size, queries, [&]()
+		{
+			for (unsigned int i = 0; i < queries; ++i)
+				m_Sink += algorithm.GetShortestPathLength(compact, m_Random() % (size * size), m_Random() % (size * size));
+		});
+
+		Measure("Hex/ShortestPath/Bidirectional", size, queries, [&]()
+		{
+			for (unsigned int i = 0; i < queries; ++i)
+				m_Sink += algorithm.GetShortestPathLengthBidirectional(compact, compact, m_Random() % (size * size), m_Random() % (size * size));
+		});
+
+		Measure("Hex/ShortestPath/AStar", size, queries, [&]()
+		{
+			for (unsigned int i = 0; i < queries; ++i)
+				m_Sink += algorithm.GetShortestPathLengthAStar(compact, m_Random() % (size * size), m_Random() % (size * size), heuristic);
+		});
+	}
+}
+
+void HexBenchmark::RunTurns(unsigned int size)
+{
+	const char *players[] = { "random", "minmax", "alphabeta", "montecarloalphabeta", "montecarlo", "mcts" };
+
+	for (unsigned int i = 0; i < sizeof(players) / sizeof(players[0]); ++i)
+	{
+		string name = string("Hex/TryTurn/") + players[i];
+		if (!IsSelected(name))
+			continue;
+
+		std::ostringstream player;
+		player << players[i] << ":" << m_Options.m_MoveTime;
+		shared_ptr<IPlayer> red = CreatePlayer(player.str(), RED);
+		Hex hex(size, red, make_shared<RandomStrategyPlayer>(BLUE), BIT_BOARD);
+
+		//  A random player fails when it picks a taken field, so it tries until it makes a turn
+		MeasureOnce(name, size, [&]()
+		{
+			while (!red->TryTurn(hex))
+				;
+		});
+	}
+}
+
+void HexBenchmark::Run()
+{
+	for (auto it = m_Options.m_GraphSizes.begin(); it != m_Options.m_GraphSizes.end(); ++it)
+	{
+		RunGraph(*it);
+		RunPriorityQueue(*it);
+		RunShortestPath(*it);
+	}
+
+	for (auto it = m_Options.m_BoardSizes.begin(); it != m_Options.m_BoardSizes.end(); ++it)
+	{
+		RunHex(*it, GRAPH_BOARD);
+		if (*it <= HexBitboard::MAX_SIZE)
+			RunHex(*it, BIT_BOARD);
+	}
+
+	RunTurns(m_Options.m_TurnBoardSize);
+}
+
+void HexBenchmark::WriteJson(ostream &os) const
+{
+	os << "{\n";
+	os << "  \"options\": {\"density\": " << m_Options.m_Density << ", \"min_time\": " << m_Options.m_MinTime << ", \"move_time_ms\": "
+		<< m_Options.m_MoveTime << ", \"turn_board_size\": " << m_Options.m_TurnBoardSize << "},\n";
+	os << "  \"results\": [";
+	for (size_t i = 0; i < m_Results.size(); ++i)
+	{
+		const BenchmarkResult &result = m_Results[i];
+		os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.m_Name << "\", \"size\": " << result.m_Size << ", \"operations\": "
+			<< result.m_Operations << ", \"seconds\": " << result.m_Seconds << ", \"ns_per_op\": "
+			<< result.m_Seconds * 1e9 / result.m_Operations << "}";
+	}
+	os << "\n  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+	BenchmarkOptions options;
+
+	if (!options.Parse(argc, argv))
+	{
+		cout << "Usage: hex_benchmark [--quick] [--graph-sizes 50,100,200] [--board-sizes 5,7,11] [--density 0.1]\n"
+			"                     [--min-time seconds] [--move-time ms] [--turn-board-size 7] [--filter name]\n"
+			"                     [--output file.json] [--graph-file temporary.txt]\n";
+		return 1;
+	}
+
+	HexBenchmark benchmark(options);
+	benchmark.Run();
+
+	if (options.m_Output.empty())
+		benchmark.WriteJson(cout);
+	else
+	{
+		ofstream fout(options.m_Output);
+		benchmark.WriteJson(fout);
+	}
+
+	return 0;
+}
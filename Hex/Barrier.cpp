@@ -0,0 +1,27 @@
+///  Contains the thread barrier class implementation
+#include "Barrier.h"
+
+Barrier::Barrier(unsigned int threads) : m_Threads(threads), m_Waiting(0), m_Generation(0)
+{
+}
+
+Barrier::~Barrier()
+{
+}
+
+void Barrier::Wait()
+{
+	unique_lock<mutex> lock(m_Mutex);
+	unsigned int generation = m_Generation;
+
+	if (++m_Waiting == m_Threads)
+	{
+		m_Waiting = 0;
+		m_Generation++;
+		m_Condition.notify_all();
+		return;
+	}
+
+	while (generation == m_Generation)
+		m_Condition.wait(lock);
+}
@@ -0,0 +1,32 @@
+///  Contains the thread barrier class declaration
+
+#ifndef BARRIER_H__
+#define BARRIER_H__
+
+#include <mutex>
+#include <condition_variable>
+
+using std::mutex;
+using std::condition_variable;
+using std::unique_lock;
+
+//  This class stops the threads that call Wait until all the given number of threads call it.
+//  Then all of them continue and the barrier can be used again, so the threads of a parallel algorithm
+//  can be synchronized between its phases
+class Barrier
+{
+private:
+	mutex m_Mutex;
+	condition_variable m_Condition;
+	unsigned int m_Threads;
+	unsigned int m_Waiting;
+	//  Incremented every time all the threads reach the barrier, so a thread knows it is released
+	unsigned int m_Generation;
+public:
+	explicit Barrier(unsigned int threads);
+	~Barrier();
+
+	void Wait();
+};
+
+#endif
@@ -0,0 +1,443 @@
+///  Contains the compressed sparse row snapshot of the Graph implementation
+#include "CompactGraph.h"
+#include "MinimumSpanningTree.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+using std::ofstream;
+
+//  The snapshot file is the header and then the arrays of the offsets, the targets, the weights, the edge colors and
+//  the vertex colors. Every array starts at a multiple of 8 bytes, so the mapped arrays are aligned as in memory.
+//  Numbers are written in the byte order of the machine, a file of the other byte order is not opened
+struct SnapshotHeader
+{
+	char m_Signature[8];
+	unsigned int m_Version;
+	unsigned int m_ByteOrder;
+	unsigned int m_VerticesAmount;
+	unsigned int m_EdgesAmount;
+	unsigned int m_bIntegerWeights;
+	unsigned int m_MaxIntegerWeight;
+};
+
+static const char SNAPSHOT_SIGNATURE[8] = { 'H', 'E', 'X', 'G', 'R', 'A', 'P', 'H' };
+static const unsigned int SNAPSHOT_VERSION = 1;
+static const unsigned int SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+//  Indexes of the arrays of the snapshot file
+enum SnapshotArray
+{
+	SNAPSHOT_OFFSETS,
+	SNAPSHOT_TARGETS,
+	SNAPSHOT_WEIGHTS,
+	SNAPSHOT_EDGE_COLORS,
+	SNAPSHOT_VERTEX_COLORS,
+	SNAPSHOT_END
+};
+
+//  Get the lengths of the arrays in bytes and their positions in the snapshot file, SNAPSHOT_END is the size of the file
+static void GetSnapshotLayout(unsigned int size, unsigned int edgesAmount, unsigned long long lengths[SNAPSHOT_END],
+	unsigned long long positions[SNAPSHOT_END + 1])
+{
+	lengths[SNAPSHOT_OFFSETS] = (size + 1ULL) * sizeof(unsigned int);
+	lengths[SNAPSHOT_TARGETS] = edgesAmount * static_cast<unsigned long long>(sizeof(unsigned int));
+	lengths[SNAPSHOT_WEIGHTS] = edgesAmount * static_cast<unsigned long long>(sizeof(double));
+	lengths[SNAPSHOT_EDGE_COLORS] = edgesAmount;
+	lengths[SNAPSHOT_VERTEX_COLORS] = size;
+
+	positions[0] = sizeof(SnapshotHeader);
+	for (unsigned int i = 0; i < SNAPSHOT_END; ++i)
+		positions[i + 1] = (positions[i] + lengths[i] + 7) / 8 * 8;
+}
+
+CompactGraph::CompactGraph() : m_Offsets(1, 0), m_bIntegerWeights(true), m_MaxIntegerWeight(0)
+{
+	UpdateArrays();
+}
+
+CompactGraph::CompactGraph(const Graph &graph) : m_Offsets(graph.GetVerticesAmount() + 1, 0), m_VertexColors(graph.GetVerticesAmount())
+{
+	unsigned int size = graph.GetVerticesAmount();
+
+	//  The first pass counts the edges, so the arrays are allocated once
+	for (unsigned int v = 0; v < size; ++v)
+	{
+		const list<Edge> &edges = graph.GetNodeEdges(v);
+		unsigned int degree = 0;
+		for (auto it = edges.begin(); it != edges.end(); ++it)
+			if (it->GetEndVertexNumber() < size)
+				degree++;
+		m_Offsets[v + 1] = m_Offsets[v] + degree;
+		m_VertexColors[v] = static_cast<unsigned char>(graph.GetVertexColor(v));
+	}
+
+	m_Targets.resize(m_Offsets[size]);
+	m_Weights.resize(m_Offsets[size]);
+	m_EdgeColors.resize(m_Offsets[size]);
+	for (unsigned int v = 0; v < size; ++v)
+	{
+		const list<Edge> &edges = graph.GetNodeEdges(v);
+		unsigned int e = m_Offsets[v];
+		for (auto it = edges.begin(); it != edges.end(); ++it)
+		{
+			if (it->GetEndVertexNumber() >= size)
+				continue;
+			m_Targets[e] = it->GetEndVertexNumber();
+			m_Weights[e] = it->GetEdgeWeight();
+			m_EdgeColors[e] = static_cast<unsigned char>(it->GetEdgeColor());
+			e++;
+		}
+	}
+
+	UpdateArrays();
+	UpdateIntegerWeights();
+}
+
+//  Counting sort of the edges by their start vertex. It is stable, so edges of a vertex keep their order
+template<typename TEdge>
+void CompactGraph::Build(unsigned int size, size_t edgesAmount, TEdge edge)
+{
+	unsigned int source, target;
+	double weight;
+	PlayerColor color;
+
+	m_Offsets.assign(size + 1, 0);
+	m_VertexColors.assign(size, NONE);
+	for (size_t i = 0; i < edgesAmount; ++i)
+	{
+		edge(i, source, target, weight, color);
+		if (source < size && target < size)
+			m_Offsets[source + 1]++;
+	}
+	for (unsigned int v = 0; v < size; ++v)
+		m_Offsets[v + 1] += m_Offsets[v];
+
+	vector<unsigned int> next(m_Offsets.begin(), m_Offsets.end() - 1);
+	m_Targets.resize(m_Offsets[size]);
+	m_Weights.resize(m_Offsets[size]);
+	m_EdgeColors.resize(m_Offsets[size]);
+	for (size_t i = 0; i < edgesAmount; ++i)
+	{
+		edge(i, source, target, weight, color);
+		if (source >= size || target >= size)
+			continue;
+		unsigned int e = next[source]++;
+		m_Targets[e] = target;
+		m_Weights[e] = weight;
+		m_EdgeColors[e] = static_cast<unsigned char>(color);
+	}
+
+	UpdateArrays();
+	UpdateIntegerWeights();
+}
+
+CompactGraph::CompactGraph(unsigned int size, const vector<Edge> &edges)
+{
+	Build(size, edges.size(), [&](size_t i, unsigned int &source, unsigned int &target, double &weight, PlayerColor &color)
+	{
+		source = edges[i].GetStartVertexNumber();
+		target = edges[i].GetEndVertexNumber();
+		weight = edges[i].GetEdgeWeight();
+		color = edges[i].GetEdgeColor();
+	});
+}
+
+CompactGraph::CompactGraph(unsigned int size, const vector<unsigned int> &sources, const vector<unsigned int> &targets,
+	const vector<double> &weights)
+{
+	Build(size, sources.size(), [&](size_t i, unsigned int &source, unsigned int &target, double &weight, PlayerColor &color)
+	{
+		source = sources[i];
+		target = targets[i];
+		weight = weights[i];
+		color = NONE;
+	});
+}
+
+CompactGraph::CompactGraph(const CompactGraph &graph) : m_Offsets(graph.m_Offsets), m_Targets(graph.m_Targets), m_Weights(graph.m_Weights),
+	m_EdgeColors(graph.m_EdgeColors), m_VertexColors(graph.m_VertexColors), m_File(graph.m_File),
+	m_bIntegerWeights(graph.m_bIntegerWeights), m_MaxIntegerWeight(graph.m_MaxIntegerWeight)
+{
+	UpdateArrays(graph);
+}
+
+CompactGraph::CompactGraph(CompactGraph &&graph) : m_Offsets(move(graph.m_Offsets)), m_Targets(move(graph.m_Targets)),
+	m_Weights(move(graph.m_Weights)), m_EdgeColors(move(graph.m_EdgeColors)), m_VertexColors(move(graph.m_VertexColors)),
+	m_File(move(graph.m_File)), m_bIntegerWeights(graph.m_bIntegerWeights), m_MaxIntegerWeight(graph.m_MaxIntegerWeight)
+{
+	UpdateArrays(graph);
+	graph.Clear();
+}
+
+CompactGraph::~CompactGraph()
+{
+}
+
+CompactGraph &CompactGraph::operator=(const CompactGraph &graph)
+{
+	if (this != &graph)
+	{
+		m_Offsets = graph.m_Offsets;
+		m_Targets = graph.m_Targets;
+		m_Weights = graph.m_Weights;
+		m_EdgeColors = graph.m_EdgeColors;
+		m_VertexColors = graph.m_VertexColors;
+		m_File = graph.m_File;
+		m_bIntegerWeights = graph.m_bIntegerWeights;
+		m_MaxIntegerWeight = graph.m_MaxIntegerWeight;
+		UpdateArrays(graph);
+	}
+	return *this;
+}
+
+CompactGraph &CompactGraph::operator=(CompactGraph &&graph)
+{
+	if (this != &graph)
+	{
+		m_Offsets = move(graph.m_Offsets);
+		m_Targets = move(graph.m_Targets);
+		m_Weights = move(graph.m_Weights);
+		m_EdgeColors = move(graph.m_EdgeColors);
+		m_VertexColors = move(graph.m_VertexColors);
+		m_File = move(graph.m_File);
+		m_bIntegerWeights = graph.m_bIntegerWeights;
+		m_MaxIntegerWeight = graph.m_MaxIntegerWeight;
+		UpdateArrays(graph);
+		graph.Clear();
+	}
+	return *this;
+}
+
+//  A moved graph is left empty, so its arrays don't point to the vectors or the file another graph has taken
+void CompactGraph::Clear()
+{
+	m_Offsets.assign(1, 0);
+	m_Targets.clear();
+	m_Weights.clear();
+	m_EdgeColors.clear();
+	m_VertexColors.clear();
+	m_File.reset();
+	m_bIntegerWeights = true;
+	m_MaxIntegerWeight = 0;
+	UpdateArrays();
+}
+
+void CompactGraph::UpdateArrays()
+{
+	m_pOffsets = m_Offsets.data();
+	m_pTargets = m_Targets.data();
+	m_pWeights = m_Weights.data();
+	m_pEdgeColors = m_EdgeColors.data();
+	m_pVertexColors = m_VertexColors.data();
+	m_Size = static_cast<unsigned int>(m_VertexColors.size());
+	m_EdgesAmount = static_cast<unsigned int>(m_Targets.size());
+}
+
+void CompactGraph::UpdateArrays(const CompactGraph &graph)
+{
+	if (m_File == nullptr)
+	{
+		UpdateArrays();
+		return;
+	}
+
+	m_pOffsets = graph.m_pOffsets;
+	m_pTargets = graph.m_pTargets;
+	m_pWeights = graph.m_pWeights;
+	m_pEdgeColors = graph.m_pEdgeColors;
+	m_pVertexColors = graph.m_pVertexColors;
+	m_Size = graph.m_Size;
+	m_EdgesAmount = graph.m_EdgesAmount;
+}
+
+//  The arrays are written as they are in memory, so the file is streamed without building it first
+bool CompactGraph::SaveSnapshot(const string &filename) const
+{
+	//  The file is written under another name and renamed, so the graphs that map the old file (in this process or
+	//  in others) keep reading it instead of a truncated file. A graph can be saved to the file it is mapped from
+	string temporary = filename + ".tmp";
+	ofstream fout(temporary, ios_base::out | ios_base::binary | ios_base::trunc);
+	SnapshotHeader header;
+	unsigned long long lengths[SNAPSHOT_END], positions[SNAPSHOT_END + 1];
+	const char *arrays[SNAPSHOT_END] =
+	{
+		reinterpret_cast<const char *>(m_pOffsets),
+		reinterpret_cast<const char *>(m_pTargets),
+		reinterpret_cast<const char *>(m_pWeights),
+		reinterpret_cast<const char *>(m_pEdgeColors),
+		reinterpret_cast<const char *>(m_pVertexColors)
+	};
+	const char padding[8] = { 0 };
+
+	if (!fout.good())
+		return false;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.m_Signature, SNAPSHOT_SIGNATURE, sizeof(SNAPSHOT_SIGNATURE));
+	header.m_Version = SNAPSHOT_VERSION;
+	header.m_ByteOrder = SNAPSHOT_BYTE_ORDER;
+	header.m_VerticesAmount = m_Size;
+	header.m_EdgesAmount = m_EdgesAmount;
+	header.m_bIntegerWeights = m_bIntegerWeights ? 1 : 0;
+	header.m_MaxIntegerWeight = m_MaxIntegerWeight;
+	fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	GetSnapshotLayout(m_Size, m_EdgesAmount, lengths, positions);
+	for (unsigned int i = 0; i < SNAPSHOT_END; ++i)
+	{
+		fout.write(arrays[i], static_cast<std::streamsize>(lengths[i]));
+		fout.write(padding, static_cast<std::streamsize>(positions[i + 1] - positions[i] - lengths[i]));
+	}
+
+	fout.close();
+#ifdef _WIN32
+	//  rename doesn't replace an existing file on Windows. A mapped file can't be removed, then the rename fails
+	remove(filename.c_str());
+#endif
+	if (fout.fail() || rename(temporary.c_str(), filename.c_str()) != 0)
+	{
+		remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool CompactGraph::OpenSnapshot(const string &filename)
+{
+	shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+	SnapshotHeader header;
+	unsigned long long lengths[SNAPSHOT_END], positions[SNAPSHOT_END + 1];
+
+	if (!file->Open(filename) || file->GetSize() < sizeof(header))
+		return false;
+
+	memcpy(&header, file->GetData(), sizeof(header));
+	if (memcmp(header.m_Signature, SNAPSHOT_SIGNATURE, sizeof(SNAPSHOT_SIGNATURE)) != 0 || header.m_Version != SNAPSHOT_VERSION ||
+		header.m_ByteOrder != SNAPSHOT_BYTE_ORDER)
+		return false;
+
+	GetSnapshotLayout(header.m_VerticesAmount, header.m_EdgesAmount, lengths, positions);
+	if (file->GetSize() != positions[SNAPSHOT_END])
+		return false;
+
+	const char *data = file->GetData();
+	const unsigned int *offsets = reinterpret_cast<const unsigned int *>(data + positions[SNAPSHOT_OFFSETS]);
+	if (offsets[0] != 0 || offsets[header.m_VerticesAmount] != header.m_EdgesAmount)
+		return false;
+
+	vector<unsigned int>().swap(m_Offsets);
+	vector<unsigned int>().swap(m_Targets);
+	vector<double>().swap(m_Weights);
+	vector<unsigned char>().swap(m_EdgeColors);
+	vector<unsigned char>().swap(m_VertexColors);
+
+	m_pOffsets = offsets;
+	m_pTargets = reinterpret_cast<const unsigned int *>(data + positions[SNAPSHOT_TARGETS]);
+	m_pWeights = reinterpret_cast<const double *>(data + positions[SNAPSHOT_WEIGHTS]);
+	m_pEdgeColors = reinterpret_cast<const unsigned char *>(data + positions[SNAPSHOT_EDGE_COLORS]);
+	m_pVertexColors = reinterpret_cast<const unsigned char *>(data + positions[SNAPSHOT_VERTEX_COLORS]);
+	m_Size = header.m_VerticesAmount;
+	m_EdgesAmount = header.m_EdgesAmount;
+	m_bIntegerWeights = header.m_bIntegerWeights != 0;
+	m_MaxIntegerWeight = header.m_MaxIntegerWeight;
+	m_File = file;
+	return true;
+}
+
+void CompactGraph::UpdateIntegerWeights()
+{
+	m_bIntegerWeights = true;
+	m_MaxIntegerWeight = 0;
+
+	for (auto it = m_Weights.begin(); it != m_Weights.end(); ++it)
+	{
+		if (!(*it >= 0.0 && *it <= UINT_MAX && *it == floor(*it)))
+		{
+			m_bIntegerWeights = false;
+			m_MaxIntegerWeight = 0;
+			return;
+		}
+		m_MaxIntegerWeight = std::max(m_MaxIntegerWeight, static_cast<unsigned int>(*it));
+	}
+}
+
+CompactGraph CompactGraph::GetReversed() const
+{
+	vector<Edge> edges;
+
+	edges.reserve(GetEdgesAmount());
+	for (unsigned int v = 0; v < GetVerticesAmount(); ++v)
+		for (unsigned int e = m_pOffsets[v]; e < m_pOffsets[v + 1]; ++e)
+			edges.push_back(Edge(m_pTargets[e], v, m_pWeights[e], GetEdgeColor(e)));
+
+	CompactGraph reversed(GetVerticesAmount(), edges);
+	reversed.m_VertexColors.assign(m_pVertexColors, m_pVertexColors + m_Size);
+	reversed.UpdateArrays();
+	return reversed;
+}
+
+bool CompactGraph::Adjacent(unsigned int v1, unsigned int v2) const
+{
+	if (v1 >= GetVerticesAmount())
+		return false;
+
+	for (unsigned int e = m_pOffsets[v1]; e < m_pOffsets[v1 + 1]; ++e)
+		if (m_pTargets[e] == v2)
+			return true;
+
+	return false;
+}
+
+double CompactGraph::GetEdgeValue(unsigned int v1, unsigned int v2) const
+{
+	if (v1 >= GetVerticesAmount())
+		return -1;
+
+	for (unsigned int e = m_pOffsets[v1]; e < m_pOffsets[v1 + 1]; ++e)
+		if (m_pTargets[e] == v2)
+			return m_pWeights[e];
+
+	//  if there is no edge return negative value
+	return -1;
+}
+
+Graph CompactGraph::PrimMST(double &length) const
+{
+	MinimumSpanningTreeAlgorithm algorithm;
+
+	return algorithm.PrimMST(*this, length);
+}
+
+//  Breadth-first search over the edges of the color of v. Every vertex is expanded once, the array of the visited
+//  vertices replaces the search in the list of connections
+list<unsigned int> CompactGraph::GetConnections(unsigned int v) const
+{
+	list<unsigned int> connections;
+	PlayerColor playerColor = GetVertexColor(v);
+	vector<bool> visited(GetVerticesAmount(), false);
+	vector<unsigned int> queue;
+
+	connections.push_back(v);
+	visited[v] = true;
+	for (unsigned int e = m_pOffsets[v]; e < m_pOffsets[v + 1]; ++e)
+		if (GetEdgeColor(e) == playerColor)
+			queue.push_back(m_pTargets[e]);
+
+	for (size_t i = 0; i < queue.size() && connections.size() != GetVerticesAmount(); ++i)
+	{
+		unsigned int vertex = queue[i];
+		if (visited[vertex])
+			continue;
+
+		visited[vertex] = true;
+		if (GetVertexColor(vertex) == playerColor)
+			connections.push_back(vertex);
+		for (unsigned int e = m_pOffsets[vertex]; e < m_pOffsets[vertex + 1]; ++e)
+			if (GetEdgeColor(e) == playerColor && !visited[m_pTargets[e]])
+				queue.push_back(m_pTargets[e]);
+	}
+
+	return connections;
+}
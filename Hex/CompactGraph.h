@@ -0,0 +1,115 @@
+///  Contains the compressed sparse row snapshot of the Graph declaration
+
+#ifndef COMPACTGRAPH_H__
+#define COMPACTGRAPH_H__
+
+#include "Graph.h"
+#include "MappedFile.h"
+
+using std::shared_ptr;
+
+//  This class is an immutable copy of a Graph in the compressed sparse row layout.
+//  Edges of the vertex v are the indexes from m_Offsets[v] to m_Offsets[v + 1] of the m_Targets, m_Weights and
+//  m_EdgeColors arrays, in the order they have in the adjacency list of the Graph. A neighbor visit reads contiguous
+//  memory instead of following the pointers of a list, so it is used for the read-heavy algorithms on a graph that
+//  doesn't change any more: build a Graph, freeze it and run the queries on the frozen copy.
+//  The arrays can be saved to a binary snapshot file. OpenSnapshot maps the file into memory and reads the arrays
+//  right from the mapped pages, so a big graph is opened without parsing and copying and the processes that open
+//  the same snapshot share its memory
+class CompactGraph
+{
+private:
+	//  Arrays of a graph built in memory, they are empty when the graph is read from a snapshot file
+	vector<unsigned int> m_Offsets;
+	vector<unsigned int> m_Targets;
+	vector<double> m_Weights;
+	vector<unsigned char> m_EdgeColors;
+	vector<unsigned char> m_VertexColors;
+	//  The arrays all the methods read: the vectors above or the mapped snapshot file
+	const unsigned int *m_pOffsets;
+	const unsigned int *m_pTargets;
+	const double *m_pWeights;
+	const unsigned char *m_pEdgeColors;
+	const unsigned char *m_pVertexColors;
+	unsigned int m_Size;
+	unsigned int m_EdgesAmount;
+	//  The snapshot file, shared by the copies of the graph
+	shared_ptr<MappedFile> m_File;
+	//  If all the weights are non-negative integers the search can use an integer queue (see IntegerShortestPathAlgorithm)
+	bool m_bIntegerWeights;
+	unsigned int m_MaxIntegerWeight;
+
+	//  Make the graph empty
+	void Clear();
+	//  Point the arrays to the vectors
+	void UpdateArrays();
+	//  Point the arrays to the vectors or to the mapped file the graph has the same arrays as
+	void UpdateArrays(const CompactGraph &graph);
+	//  Find out if all the weights are integers and the biggest of them
+	void UpdateIntegerWeights();
+	//  Counting sort of the edges by their start vertex. edge(i, source, target, weight, color) gets the edge i of edgesAmount
+	template<typename TEdge>
+	void Build(unsigned int size, size_t edgesAmount, TEdge edge);
+public:
+	//  An empty graph
+	CompactGraph();
+	//  Freeze the Graph
+	explicit CompactGraph(const Graph &graph);
+	//  Build the graph of the given size from a list of edges at once, without building a Graph first.
+	//  Edges of a vertex keep their order in the list. Edges with a vertex out of range are skipped
+	CompactGraph(unsigned int size, const vector<Edge> &edges);
+	//  The same for the edges given by the arrays of their start vertices, end vertices and weights
+	CompactGraph(unsigned int size, const vector<unsigned int> &sources, const vector<unsigned int> &targets, const vector<double> &weights);
+	CompactGraph(const CompactGraph &graph);
+	CompactGraph(CompactGraph &&graph);
+	~CompactGraph();
+
+	CompactGraph &operator=(const CompactGraph &graph);
+	CompactGraph &operator=(CompactGraph &&graph);
+
+	//  Write the graph to a binary snapshot file, false if it can't be written. The file is replaced at once,
+	//  the graphs that have mapped the old file keep its contents
+	bool SaveSnapshot(const string &filename) const;
+	//  Map a snapshot file written by SaveSnapshot and read the graph from it. Only the header is checked, the arrays
+	//  are trusted. False if the file can't be mapped or is not a snapshot of this version, the graph isn't changed then
+	bool OpenSnapshot(const string &filename);
+	//  Check if the graph is read from a mapped snapshot file
+	bool IsMapped() const { return m_File != nullptr; }
+
+	unsigned int GetVerticesAmount() const { return m_Size; }
+	unsigned int GetEdgesAmount() const { return m_EdgesAmount; }
+	PlayerColor GetVertexColor(unsigned int v) const { return static_cast<PlayerColor>(m_pVertexColors[v]); }
+	//  Edges of the vertex v are the indexes from GetEdgesBegin(v) to GetEdgesEnd(v)
+	unsigned int GetEdgesBegin(unsigned int v) const { return m_pOffsets[v]; }
+	unsigned int GetEdgesEnd(unsigned int v) const { return m_pOffsets[v + 1]; }
+	unsigned int GetDegree(unsigned int v) const { return m_pOffsets[v + 1] - m_pOffsets[v]; }
+	unsigned int GetEdgeTarget(unsigned int e) const { return m_pTargets[e]; }
+	double GetEdgeWeight(unsigned int e) const { return m_pWeights[e]; }
+	PlayerColor GetEdgeColor(unsigned int e) const { return static_cast<PlayerColor>(m_pEdgeColors[e]); }
+	//  Check if all the edge weights are non-negative integers (not more than UINT_MAX)
+	bool HasIntegerWeights() const { return m_bIntegerWeights; }
+	//  The biggest edge weight if all of them are integers, 0 otherwise
+	unsigned int GetMaxIntegerWeight() const { return m_MaxIntegerWeight; }
+
+	//  Get the graph with the same vertices and all the edges reversed (an edge from v2 to v1 for every edge from v1 to v2)
+	CompactGraph GetReversed() const;
+
+	//  Check if vertices are adjacent
+	bool Adjacent(unsigned int v1, unsigned int v2) const;
+	//  Get edge weight by its vertices, -1 if there is no edge
+	double GetEdgeValue(unsigned int v1, unsigned int v2) const;
+	//  Call function(target, weight) for every edge of the vertex v
+	template<typename TFunction>
+	void ForEachEdge(unsigned int v, TFunction function) const
+	{
+		for (unsigned int e = m_pOffsets[v], end = m_pOffsets[v + 1]; e < end; ++e)
+			function(m_pTargets[e], m_pWeights[e]);
+	}
+
+	//  Prim's algorithm, the same tree and length as Graph::PrimMST gives for the frozen graph
+	Graph PrimMST(double &length) const;
+	//  Get list of the vertices we can get to form a given vertex, the same as Graph::GetConnections
+	list<unsigned int> GetConnections(unsigned int v) const;
+};
+
+#endif
@@ -0,0 +1,63 @@
+///  Contains the concurrent disjoint set (union-find) class implementation
+#include "ConcurrentDisjointSet.h"
+#include <utility>
+
+ConcurrentDisjointSet::ConcurrentDisjointSet(unsigned int size) : m_Parent(size)
+{
+	for (unsigned int i = 0; i < size; ++i)
+		m_Parent[i].store(i, std::memory_order_relaxed);
+}
+
+ConcurrentDisjointSet::~ConcurrentDisjointSet()
+{
+}
+
+unsigned int ConcurrentDisjointSet::Find(unsigned int v)
+{
+	//  Path halving: the element is linked to its grandparent if nobody has changed its parent meanwhile
+	unsigned int parent = m_Parent[v].load(std::memory_order_acquire);
+	while (parent != v)
+	{
+		unsigned int grandparent = m_Parent[parent].load(std::memory_order_acquire);
+		if (grandparent != parent)
+			m_Parent[v].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel, std::memory_order_acquire);
+		v = grandparent;
+		parent = m_Parent[v].load(std::memory_order_acquire);
+	}
+
+	return v;
+}
+
+bool ConcurrentDisjointSet::Union(unsigned int v1, unsigned int v2)
+{
+	while (true)
+	{
+		unsigned int root1 = Find(v1);
+		unsigned int root2 = Find(v2);
+
+		if (root1 == root2)
+			return false;
+		if (root1 < root2)
+			std::swap(root1, root2);
+
+		//  root1 may have been linked by another thread since it was found, then try again from the new roots
+		unsigned int expected = root1;
+		if (m_Parent[root1].compare_exchange_strong(expected, root2, std::memory_order_acq_rel, std::memory_order_acquire))
+			return true;
+	}
+}
+
+bool ConcurrentDisjointSet::Connected(unsigned int v1, unsigned int v2)
+{
+	//  Different roots mean different sets only if the first root is still a root after the second one is found
+	while (true)
+	{
+		unsigned int root1 = Find(v1);
+		unsigned int root2 = Find(v2);
+
+		if (root1 == root2)
+			return true;
+		if (m_Parent[root1].load(std::memory_order_acquire) == root1)
+			return false;
+	}
+}
@@ -0,0 +1,39 @@
+///  Contains the concurrent disjoint set (union-find) class declaration
+
+#ifndef CONCURRENT_DISJOINT_SET_H__
+#define CONCURRENT_DISJOINT_SET_H__
+
+#include <atomic>
+#include <vector>
+
+using std::atomic;
+using std::vector;
+
+//  This class implements a disjoint set forest over the elements 0..size-1 that many threads can change at once
+//  without locks. A root is linked with a compare-and-swap of its parent, which fails if another thread has linked
+//  the root first, then the roots are found again. The root with the bigger number is always linked to the smaller
+//  one, so the links can't make a cycle and the representative of a set is its smallest element.
+//  Find uses path halving: a thread that links an element to its grandparent only makes the path shorter,
+//  so the writes need no synchronization. It has no rollback, see DisjointSet for that
+class ConcurrentDisjointSet
+{
+private:
+	vector<atomic<unsigned int>> m_Parent;
+public:
+	//  Construct a forest where every element is a separate set
+	explicit ConcurrentDisjointSet(unsigned int size);
+	~ConcurrentDisjointSet();
+
+	//  Get the number of elements in the forest
+	unsigned int Size() const { return static_cast<unsigned int>(m_Parent.size()); }
+
+	//  Get the representative of the set containing the element, the smallest element of the set
+	unsigned int Find(unsigned int v);
+	//  Merge the sets containing v1 and v2. Returns false if they already were in one set.
+	//  Of the threads that merge the same two sets only one gets true
+	bool Union(unsigned int v1, unsigned int v2);
+	//  Check if two elements are in the same set
+	bool Connected(unsigned int v1, unsigned int v2);
+};
+
+#endif
@@ -0,0 +1,161 @@
+///  Contains the parallel delta-stepping shortest path algorithm implementation
+#include "DeltaStepping.h"
+#include "CompactGraph.h"
+#include "Threads.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+DeltaSteppingAlgorithm::DeltaSteppingAlgorithm(unsigned int threads /* = 0 */, double delta /* = 0.0 */) : m_Threads(0), m_Delta(delta),
+	m_LastDelta(0.0), m_Phases(0)
+{
+	SetThreads(threads);
+}
+
+DeltaSteppingAlgorithm::~DeltaSteppingAlgorithm()
+{
+}
+
+void DeltaSteppingAlgorithm::SetThreads(unsigned int threads)
+{
+	m_Threads = GetThreadCount(threads);
+}
+
+template<typename TGraph>
+double DeltaSteppingAlgorithm::GetMaxWeight(const TGraph &G, unsigned long long &edges)
+{
+	double maxWeight = 0.0;
+
+	edges = 0;
+	for (unsigned int v = 0; v < G.GetVerticesAmount(); ++v)
+		G.ForEachEdge(v, [&](unsigned int, double weight)
+		{
+			maxWeight = std::max(maxWeight, weight);
+			edges++;
+		});
+
+	return maxWeight;
+}
+
+template<typename TGraph>
+void DeltaSteppingAlgorithm::ShortestDistances(const TGraph &G, unsigned int u, vector<double> &distances)
+{
+	//  The vertices of the current bucket are taken by the threads in blocks
+	const size_t block = 64;
+	const size_t NO_BUCKET = SIZE_MAX;
+	unsigned int size = G.GetVerticesAmount();
+	unsigned long long edges = 0;
+	double maxWeight = GetMaxWeight(G, edges);
+	double delta = m_Delta;
+
+	if (!(delta > 0.0))
+		delta = maxWeight > 0.0 && edges > 0 ? maxWeight * size / edges : 1.0;
+	//  A shortest distance is less than V * maxWeight, so a smaller delta only makes more empty buckets
+	if (delta < maxWeight / size)
+		delta = maxWeight / size;
+	//  A vertex of the bucket i gets distances of the buckets from i to i + maxWeight / delta + 1, one more bucket
+	//  is for the rounding of the division. An infinite weight makes delta infinite, then all the vertices are in one bucket
+	size_t bucketsAmount = std::isfinite(maxWeight / delta) ? static_cast<size_t>(maxWeight / delta) + 3 : 1;
+
+	vector<atomic<double>> distance(size);
+	for (unsigned int v = 0; v < size; ++v)
+		distance[v].store(DBL_MAX, std::memory_order_relaxed);
+	distance[u].store(0.0, std::memory_order_relaxed);
+
+	//  Buckets found by every thread, the current bucket is gathered from them into the frontier between the phases.
+	//  The bucket i is buckets[t][i % bucketsAmount]
+	vector<vector<vector<unsigned int>>> buckets(m_Threads, vector<vector<unsigned int>>(bucketsAmount));
+	vector<size_t> nextBuckets(m_Threads), offsets(m_Threads + 1);
+	vector<unsigned int> frontier(1, u);
+	size_t bucket = 0;
+	atomic<size_t> next(0);
+	Barrier barrier(m_Threads);
+	m_Phases = 0;
+
+	auto worker = [&](unsigned int t)
+	{
+		vector<vector<unsigned int>> &local = buckets[t];
+
+		while (true)
+		{
+			if (t == 0)
+				m_Phases++;
+
+			//  Relax the edges of the current bucket. A vertex that has got a shorter distance of an earlier bucket
+			//  after it was put into this one has already been processed
+			for (size_t first = next.fetch_add(block); first < frontier.size(); first = next.fetch_add(block))
+				for (size_t i = first; i < first + block && i < frontier.size(); ++i)
+				{
+					unsigned int vertex = frontier[i];
+					double vertexDistance = distance[vertex].load(std::memory_order_relaxed);
+					if (static_cast<size_t>(vertexDistance / delta) < bucket)
+						continue;
+
+					G.ForEachEdge(vertex, [&](unsigned int target, double weight)
+					{
+						double newDistance = vertexDistance + weight;
+						double oldDistance = distance[target].load(std::memory_order_relaxed);
+						while (newDistance < oldDistance)
+						{
+							if (distance[target].compare_exchange_weak(oldDistance, newDistance, std::memory_order_relaxed))
+							{
+								local[static_cast<size_t>(newDistance / delta) % bucketsAmount].push_back(target);
+								break;
+							}
+						}
+					});
+				}
+
+			//  The next bucket is the first non-empty one of all the threads, it can be the current one again
+			nextBuckets[t] = NO_BUCKET;
+			for (size_t b = bucket; b < bucket + bucketsAmount; ++b)
+				if (!local[b % bucketsAmount].empty())
+				{
+					nextBuckets[t] = b;
+					break;
+				}
+			barrier.Wait();
+
+			if (t == 0)
+			{
+				bucket = *std::min_element(nextBuckets.begin(), nextBuckets.end());
+				offsets[0] = 0;
+				for (unsigned int i = 0; i < m_Threads; ++i)
+					offsets[i + 1] = offsets[i] + (bucket != NO_BUCKET ? buckets[i][bucket % bucketsAmount].size() : 0);
+				frontier.resize(offsets[m_Threads]);
+				next.store(0);
+			}
+			barrier.Wait();
+
+			if (bucket == NO_BUCKET)
+				break;
+			std::copy(local[bucket % bucketsAmount].begin(), local[bucket % bucketsAmount].end(), frontier.begin() + offsets[t]);
+			local[bucket % bucketsAmount].clear();
+			barrier.Wait();
+		}
+	};
+
+	RunThreads(m_Threads, worker);
+
+	m_LastDelta = delta;
+	distances.resize(size);
+	for (unsigned int v = 0; v < size; ++v)
+	{
+		double d = distance[v].load(std::memory_order_relaxed);
+		distances[v] = d == DBL_MAX ? -1.0 : d;
+	}
+}
+
+vector<double> DeltaSteppingAlgorithm::GetShortestDistances(const Graph &G, unsigned int u)
+{
+	vector<double> distances;
+	ShortestDistances(G, u, distances);
+	return distances;
+}
+
+vector<double> DeltaSteppingAlgorithm::GetShortestDistances(const CompactGraph &G, unsigned int u)
+{
+	vector<double> distances;
+	ShortestDistances(G, u, distances);
+	return distances;
+}
@@ -0,0 +1,54 @@
+///  Contains the parallel delta-stepping shortest path algorithm declaration
+
+#ifndef DELTASTEPPING_H__
+#define DELTASTEPPING_H__
+
+#include "Graph.h"
+#include "Barrier.h"
+
+//  This class implements the delta-stepping single source shortest path algorithm on many threads.
+//  Vertices are kept in buckets by their distance: the bucket i has the vertices with the distance from i * delta
+//  to (i + 1) * delta. The buckets are processed in order and all the vertices of the current bucket relax their edges
+//  in parallel. A shorter distance is written with a compare-and-swap, the vertex goes to the bucket of its new distance
+//  in the buckets of the thread that has found it. An edge lighter than delta can put a vertex back to the current
+//  bucket, then the bucket is processed again. A small delta means less useless relaxations and more phases,
+//  a big one means more work in every phase and less synchronization. A new distance is less than the maximum edge weight
+//  after the current bucket, so the buckets are a cyclic array of maxWeight / delta + 2 buckets, and delta is never less
+//  than maxWeight / V, so their number is not more than V + 2 whatever delta is set.
+//  Distances are the same as ShortestPathAlgorithm::GetShortestDistances gives: the minimum doesn't depend on
+//  the order of the relaxations. Edge weights must not be negative
+class DeltaSteppingAlgorithm
+{
+private:
+	unsigned int m_Threads;
+	double m_Delta;
+	//  Delta and the number of processed buckets of the last search
+	double m_LastDelta;
+	unsigned int m_Phases;
+
+	//  Get the maximum edge weight and the number of the edges
+	template<typename TGraph>
+	static double GetMaxWeight(const TGraph &G, unsigned long long &edges);
+	template<typename TGraph>
+	void ShortestDistances(const TGraph &G, unsigned int u, vector<double> &distances);
+public:
+	//  threads == 0 means one thread per hardware core, delta == 0 means a delta chosen for every graph:
+	//  the maximum edge weight divided by the average degree
+	explicit DeltaSteppingAlgorithm(unsigned int threads = 0, double delta = 0.0);
+	~DeltaSteppingAlgorithm();
+
+	//  Get the shortest Path Lengths from the vertex u to all the vertices of the Graph G.
+	//  The length to u is 0, the length to a vertex that can't be reached is -1
+	vector<double> GetShortestDistances(const Graph &G, unsigned int u);
+	vector<double> GetShortestDistances(const CompactGraph &G, unsigned int u);
+
+	unsigned int GetThreads() const { return m_Threads; }
+	void SetThreads(unsigned int threads);
+	double GetDelta() const { return m_Delta; }
+	void SetDelta(double delta) { m_Delta = delta; }
+	//  Delta used by the last search and the number of bucket phases it made
+	double GetLastDelta() const { return m_LastDelta; }
+	unsigned int GetPhases() const { return m_Phases; }
+};
+
+#endif
@@ -0,0 +1,87 @@
+///  Contains the disjoint set (union-find) class implementation
+#include "DisjointSet.h"
+
+DisjointSet::DisjointSet(unsigned int size) : m_Parent(size), m_Rank(size, 0), m_Checkpoints(0)
+{
+	for (unsigned int i = 0; i < size; ++i)
+		m_Parent[i] = i;
+}
+
+DisjointSet::~DisjointSet()
+{
+}
+
+unsigned int DisjointSet::Find(unsigned int v)
+{
+	//  Path halving: every visited element is linked to its grandparent
+	while (m_Parent[v] != v)
+	{
+		Record(v);
+		m_Parent[v] = m_Parent[m_Parent[v]];
+		v = m_Parent[v];
+	}
+
+	return v;
+}
+
+bool DisjointSet::Union(unsigned int v1, unsigned int v2)
+{
+	unsigned int root1 = Find(v1);
+	unsigned int root2 = Find(v2);
+
+	if (root1 == root2)
+		return false;
+
+	//  Attach the lower tree to the higher one so trees stay shallow
+	if (m_Rank[root1] < m_Rank[root2])
+	{
+		Record(root1);
+		m_Parent[root1] = root2;
+	}
+	else if (m_Rank[root1] > m_Rank[root2])
+	{
+		Record(root2);
+		m_Parent[root2] = root1;
+	}
+	else
+	{
+		Record(root2);
+		Record(root1);
+		m_Parent[root2] = root1;
+		m_Rank[root1]++;
+	}
+
+	return true;
+}
+
+void DisjointSet::Record(unsigned int v)
+{
+	if (m_Checkpoints == 0)
+		return;
+
+	Change change;
+	change.m_Element = v;
+	change.m_Parent = m_Parent[v];
+	change.m_Rank = m_Rank[v];
+	m_History.push_back(change);
+}
+
+size_t DisjointSet::Checkpoint()
+{
+	m_Checkpoints++;
+	return m_History.size();
+}
+
+void DisjointSet::Rollback(size_t mark)
+{
+	//  Changes are restored in the reverse order, so an element changed several times gets its oldest state
+	while (m_History.size() > mark)
+	{
+		const Change &change = m_History.back();
+		m_Parent[change.m_Element] = change.m_Parent;
+		m_Rank[change.m_Element] = change.m_Rank;
+		m_History.pop_back();
+	}
+
+	m_Checkpoints--;
+}
@@ -0,0 +1,58 @@
+///  Contains the disjoint set (union-find) class declaration
+
+#ifndef DISJOINT_SET_H__
+#define DISJOINT_SET_H__
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+//  This class implements a disjoint set forest over the elements 0..size-1.
+//  It uses union by rank and path halving so both Find and Union work in
+//  almost constant amortized time. It is used by the Hex board to keep track of
+//  connected groups of stones incrementally instead of searching the Graph after every move.
+//  Changes of the forest can be taken back: while there is an active checkpoint every change is recorded
+//  and Rollback restores the forest to the state it had when the checkpoint was made
+class DisjointSet
+{
+private:
+	//  A recorded change: the element and its parent and rank before the change
+	class Change
+	{
+	public:
+		unsigned int m_Element;
+		unsigned int m_Parent;
+		unsigned char m_Rank;
+	};
+
+	vector<unsigned int> m_Parent;
+	vector<unsigned char> m_Rank;
+	vector<Change> m_History;
+	unsigned int m_Checkpoints;
+
+	//  Record the element before changing it if there are active checkpoints
+	void Record(unsigned int v);
+public:
+	//  Construct a forest where every element is a separate set
+	explicit DisjointSet(unsigned int size);
+	~DisjointSet();
+
+	//  Get the number of elements in the forest
+	unsigned int Size() const { return m_Parent.size(); }
+
+	//  Get the representative of the set containing the element
+	unsigned int Find(unsigned int v);
+	//  Merge the sets containing v1 and v2. Returns false if they already were in one set
+	bool Union(unsigned int v1, unsigned int v2);
+	//  Check if two elements are in the same set
+	bool Connected(unsigned int v1, unsigned int v2) { return Find(v1) == Find(v2); }
+
+	//  Start recording changes. Returns the mark to pass to Rollback
+	size_t Checkpoint();
+	//  Take back all the changes made since the checkpoint with the given mark. Checkpoints are nested,
+	//  so the last made checkpoint must be rolled back first
+	void Rollback(size_t mark);
+};
+
+#endif
@@ -1,5 +1,12 @@
 ///  Contains Graph related classes implementation
 #include "Graph.h"
+#include "CompactGraph.h"
+#include "IntegerShortestPath.h"
+#include "GraphLoader.h"
+#include "MinimumSpanningTree.h"
+#include "RandomGraph.h"
+#include "Threads.h"
+#include <iostream>
 
 //  This function generates a random double between dMin and dMax
 double GenerateRandomDouble(double dMin, double dMax)
@@ -17,10 +24,30 @@ Vertex::Vertex(unsigned int vertexNumber) : m_vertexNumber(vertexNumber), m_play
 {
 }
 
-Vertex::Vertex(Vertex &&vertex) : m_vertexNumber(vertex.m_vertexNumber), m_edgeList(move(vertex.m_vertexNumber)), m_playerColor(vertex.m_playerColor)
+Vertex::Vertex(const Vertex &vertex) : m_vertexNumber(vertex.m_vertexNumber), m_edgeList(vertex.m_edgeList), m_playerColor(vertex.m_playerColor)
 {
 }
 
+Vertex::Vertex(Vertex &&vertex) : m_vertexNumber(vertex.m_vertexNumber), m_edgeList(move(vertex.m_edgeList)), m_playerColor(vertex.m_playerColor)
+{
+}
+
+Vertex &Vertex::operator=(const Vertex &vertex)
+{
+	m_vertexNumber = vertex.m_vertexNumber;
+	m_edgeList = vertex.m_edgeList;
+	m_playerColor = vertex.m_playerColor;
+	return *this;
+}
+
+Vertex &Vertex::operator=(Vertex &&vertex)
+{
+	m_vertexNumber = vertex.m_vertexNumber;
+	m_edgeList = move(vertex.m_edgeList);
+	m_playerColor = vertex.m_playerColor;
+	return *this;
+}
+
 Vertex::~Vertex()
 {
 }
@@ -117,6 +144,11 @@ bool Vertex::SetVertexColor(PlayerColor playerColor)
 	return true;
 }
 
+void Vertex::ResetVertexColor()
+{
+	m_playerColor = NONE;
+}
+
 Edge::Edge() : m_startVertex(UINT_MAX), m_endVertex(UINT_MAX), m_Weight(DBL_MAX), m_playerColor(NONE)
 {
 }
@@ -130,10 +162,28 @@ Edge::Edge(unsigned int startVertex, unsigned int endVertex, PlayerColor playerC
 
 }
 
+Edge::Edge(const Edge &edge) : m_startVertex(edge.m_startVertex), m_endVertex(edge.m_endVertex), m_Weight(edge.m_Weight), m_playerColor(edge.m_playerColor)
+{
+}
+
 Edge::Edge(Edge && edge) : m_startVertex(edge.m_startVertex), m_endVertex(edge.m_endVertex), m_Weight(edge.m_Weight), m_playerColor(edge.m_playerColor)
 {
 }
 
+Edge &Edge::operator=(const Edge &edge)
+{
+	m_startVertex = edge.m_startVertex;
+	m_endVertex = edge.m_endVertex;
+	m_Weight = edge.m_Weight;
+	m_playerColor = edge.m_playerColor;
+	return *this;
+}
+
+Edge &Edge::operator=(Edge &&edge)
+{
+	return *this = edge;
+}
+
 Edge::~Edge()
 {
 }
@@ -175,70 +225,61 @@ Graph::Graph(unsigned int size) : m_Vertices(size), m_EdgesAmount(0)
 		it->SetVertexNumber(it - m_Vertices.begin());
 }
 
-//  This construct uses this approach to generate graph with the given density: We generate
-//  a random double between 0 and 1. If it is less than the density then create an edge.
-//  It means the edge in generated in density cases of 1 (or in density % cases).
-//  It equals that graph has the given density
-Graph::Graph(unsigned int size, double density, double distance_min, double distance_max) : m_Vertices(size), m_EdgesAmount(0)
+//  Every pair of vertices gets an edge with the probability density (see RandomGraphGenerator).
+//  The seed of the generator is taken from rand(), so srand makes the graph reproducible
+Graph::Graph(unsigned int size, double density, double distance_min, double distance_max) : m_EdgesAmount(0)
 {
-	double random_propability, random_distance;
-	random_propability = random_distance = 0.0;
+	RandomGraphGenerator generator(rand());
 
-	//  it - m_Vertices.begin() gives number of vertices between first vertex and vertex pointed by iterator(number of vertex)
+	*this = generator.GenerateGraph(size, density, distance_min, distance_max);
+}
+
+Graph::Graph(unsigned int size, const vector<unsigned int> &sources, const vector<unsigned int> &targets, const vector<double> &weights,
+	const vector<PlayerColor> &colors /* = vector<PlayerColor>() */) : m_Vertices(size), m_EdgesAmount(0)
+{
 	for (auto it = m_Vertices.begin(); it != m_Vertices.end(); ++it)
 		it->SetVertexNumber(it - m_Vertices.begin());
 
-	for (size_t i = 0; i < m_Vertices.size(); ++i)
-	{
-		m_Vertices[i].AddEdge(i, 0.0);  //  a path to itself always exists
-		m_EdgesAmount++;
-		for (size_t j = i + 1; j < m_Vertices.size(); ++j)
+	for (size_t i = 0; i < sources.size(); ++i)
+		if (sources[i] < size && targets[i] < size)
 		{
-			random_propability = GenerateRandomDouble(0.0, 1.0);
-			if (random_propability < density)
-			{
-				random_distance = GenerateRandomDouble(distance_min, distance_max);
-				//  graph is undirected so we can go from i to j and from j to i
-				m_Vertices[i].AddEdge(j, random_distance);
-				m_Vertices[j].AddEdge(i, random_distance);
-				m_EdgesAmount += 2;
-			}
+			m_Vertices[sources[i]].AddEdge(targets[i], weights[i], colors.empty() ? NONE : colors[i]);
+			m_EdgesAmount++;
 		}
-	}
 }
 
 Graph::Graph(const string &filename) : m_EdgesAmount(0)
 {
-	ifstream fin(filename, ios_base::in);
+	GraphLoader loader;
 
-	if (fin.good())
-	{
-		int size, v1, v2, len;
-		fin >> size;
-		if (fin.good())
-		{
-			m_Vertices = vector<Vertex>(size);
-			//  it - m_Vertices.begin() gives number of vertices between first vertex and vertex pointed by iterator(number of vertex)
-			for (auto it = m_Vertices.begin(); it != m_Vertices.end(); ++it)
-				it->SetVertexNumber(it - m_Vertices.begin());
+	if (loader.Load(filename))
+		*this = loader.GetGraph();
+	else
+		std::cerr << filename << ": " << loader.GetError() << "\n";
+}
 
-			while (!fin.eof())
-			{
-				fin >> v1 >> v2 >> len;
-				if (fin.eof())
-					break;
-				m_Vertices[v1].AddEdge(v2, len);
-				m_EdgesAmount++;
-			}
-		}
-	}
-	fin.close();
+Graph::Graph(const Graph &graph) : m_Vertices(graph.m_Vertices), m_EdgesAmount(graph.m_EdgesAmount)
+{
 }
 
 Graph::Graph(Graph &&graph) : m_EdgesAmount(graph.m_EdgesAmount), m_Vertices(move(graph.m_Vertices))
 {
 }
 
+Graph &Graph::operator=(const Graph &graph)
+{
+	m_Vertices = graph.m_Vertices;
+	m_EdgesAmount = graph.m_EdgesAmount;
+	return *this;
+}
+
+Graph &Graph::operator=(Graph &&graph)
+{
+	m_Vertices = move(graph.m_Vertices);
+	m_EdgesAmount = graph.m_EdgesAmount;
+	return *this;
+}
+
 Graph::~Graph()
 {
 }
@@ -341,6 +382,11 @@ bool Graph::SetVertexColor(unsigned int v, PlayerColor playerColor)
 	return m_Vertices[v].SetVertexColor(playerColor);
 }
 
+void Graph::ResetVertexColor(unsigned int v)
+{
+	m_Vertices[v].ResetVertexColor();
+}
+
 bool Graph::SetEdgeColor(unsigned int v1, unsigned int v2, PlayerColor playerColor)
 {
 	list<Edge> &edges = m_Vertices[v1].GetNodeEdges();
@@ -363,60 +409,28 @@ void Graph::SetEdgeValue(unsigned int v1, unsigned int v2, double value)
 	m_Vertices[v2].SetEdgeValue(v1, value);
 }
 
-Graph Graph::PrimMST(double &length)
+Graph Graph::GetReversed() const
 {
 	Graph G(GetVerticesAmount());
-	list<unsigned int> closeSet;
-	PriorityQueue<Edge, double> PQ;
-	//  we should check if the Graph is disconnected and return the tree of 0 size in that case
-	bool bDisconnected = true;
 
-	length = 0;
-	if (GetVerticesAmount() == 0)
-		return G;
-	
-	//  Start with a single vertex
-	closeSet.push_back(0);
-	for (auto it = m_Vertices[0].GetNodeEdges().begin(); it != m_Vertices[0].GetNodeEdges().end(); ++it)
-		PQ.Insert(*it, it->GetEdgeWeight());
-
-	//  Algorithm should work while the resulting tree doesn't contain all nodes 
-	//  and Graph is not disconnected (second condition)
-	while (closeSet.size() != G.GetVerticesAmount() && PQ.Size() > 0)
+	for (unsigned int v = 0; v < GetVerticesAmount(); ++v)
 	{
-		bDisconnected = true;
-		Edge e;
-		//  Get an unvisited vertex with the highest priority
-		while (PQ.Size() > 0)
-		{
-			e =  PQ.Top();
-			PQ.Pop();
-
-			if (find(closeSet.begin(), closeSet.end(), e.GetEndVertexNumber()) == closeSet.end())
-			{
-				bDisconnected = false;
-				break;
-			}
-		}
+		if (GetVertexColor(v) != NONE)
+			G.SetVertexColor(v, GetVertexColor(v));
+		const list<Edge> &edges = m_Vertices[v].GetNodeEdges();
+		for (auto it = edges.begin(); it != edges.end(); ++it)
+			if (it->GetEndVertexNumber() < GetVerticesAmount())
+				G.AddEdge(it->GetEndVertexNumber(), v, it->GetEdgeWeight(), it->GetEdgeColor());
+	}
 
-		if (bDisconnected)
-			break;
+	return G;
+}
 
-		//  Add the vertex to the tree and its edges to the queue
-		G.AddEdge(e);
-		length += e.GetEdgeWeight();
-		closeSet.push_back(e.GetEndVertexNumber());
-		for (auto it = m_Vertices[e.GetEndVertexNumber()].GetNodeEdges().begin(); it != m_Vertices[e.GetEndVertexNumber()].GetNodeEdges().end(); ++it)
-			PQ.Insert(*it, it->GetEdgeWeight());
-	}
+Graph Graph::PrimMST(double &length)
+{
+	MinimumSpanningTreeAlgorithm algorithm;
 
-	if (!bDisconnected)
-		return G;
-	else
-	{
-		length = DBL_MAX;
-		return Graph(0);
-	}
+	return algorithm.PrimMST(*this, length);
 }
 
 list<unsigned int> Graph::GetConnections(unsigned int v)
@@ -468,6 +482,10 @@ Path::Path(const Path &path, const Edge &edge) : m_Path(path.m_Path)
 	m_Weight = path.m_Weight + edge.GetEdgeWeight();
 }
 
+Path::Path(list<unsigned int> &&path, double weight) : m_Path(move(path)), m_Weight(weight)
+{
+}
+
 double Path::GetWeight() const
 {
 	return m_Weight;
@@ -499,7 +517,8 @@ void Path::AddVertex(const Edge &edge)
 	m_Weight += edge.GetEdgeWeight();
 }
 
-ShortestPathAlgorithm::ShortestPathAlgorithm() : m_CloseSet(), m_OpenSet()
+ShortestPathAlgorithm::ShortestPathAlgorithm() : m_OpenSet(), m_Stamp(0), m_OpenSetSize(0), m_CloseSet(), m_BackwardOpenSetSize(0),
+	m_bIntegerSearch(true)
 {
 }
 
@@ -507,27 +526,64 @@ ShortestPathAlgorithm::~ShortestPathAlgorithm()
 {
 }
 
-//  Check if the open set contains the vertex
-bool ShortestPathAlgorithm::OpenSetContains(unsigned int vertex) const
+void ShortestPathAlgorithm::ResetOpenSet(unsigned int size)
 {
-	for (auto it = m_OpenSet.begin(); it != m_OpenSet.end(); ++it)
-		if (*it == vertex)
-			return true;
-	return false;
+	if (m_OpenSet.size() < size)
+		m_OpenSet.resize(size, m_Stamp);
+
+	//  All the stamps are cleared once in 4 billion searches, when the stamp wraps around
+	if (++m_Stamp == 0)
+	{
+		fill(m_OpenSet.begin(), m_OpenSet.end(), 0);
+		fill(m_Reached.begin(), m_Reached.end(), 0);
+		fill(m_BackwardOpenSet.begin(), m_BackwardOpenSet.end(), 0);
+		fill(m_BackwardReached.begin(), m_BackwardReached.end(), 0);
+		m_Stamp = 1;
+	}
+	m_OpenSetSize = 0;
+	m_BackwardOpenSetSize = 0;
+}
+
+IntegerShortestPathAlgorithm *ShortestPathAlgorithm::GetIntegerAlgorithm(const CompactGraph &G)
+{
+	if (!m_bIntegerSearch || !IntegerShortestPathAlgorithm::CanSearch(G))
+		return nullptr;
+
+	if (!m_IntegerAlgorithm)
+		m_IntegerAlgorithm.reset(new IntegerShortestPathAlgorithm());
+	m_OpenSetSize = m_BackwardOpenSetSize = 0;
+	return m_IntegerAlgorithm.get();
+}
+
+void ShortestPathAlgorithm::ReserveSearchArrays(unsigned int size)
+{
+	if (m_Reached.size() >= size)
+		return;
+
+	//  Stamp 0 is never the current one
+	m_Distance.resize(size);
+	m_Reached.resize(size, 0);
+	m_BackwardOpenSet.resize(size, 0);
+	m_BackwardDistance.resize(size);
+	m_BackwardReached.resize(size, 0);
+	m_BackwardPredecessor.resize(size);
+	m_BackwardWeight.resize(size);
 }
 
 //  Get Shortest Path LENGTH from u to v
-double ShortestPathAlgorithm::GetShortestPathLength(const Graph& G, unsigned int u, unsigned int v)
+template<typename TGraph>
+double ShortestPathAlgorithm::ShortestPathLength(const TGraph &G, unsigned int u, unsigned int v)
 {
-	m_CloseSet = PriorityQueue<unsigned int, double>();
-	m_OpenSet.resize(0);
+	m_CloseSet.Reset(G.GetVerticesAmount());
+	ResetOpenSet(G.GetVerticesAmount());
 
-	const list<Edge> &firstVNeighbors = G.GetNodeEdges(u);
 	//  Add u to the open set
-	m_OpenSet.push_back(u);
+	AddToOpenSet(u);
 	//  Add all the neighboors of u to the close set
-	for (auto it = firstVNeighbors.begin(); it != firstVNeighbors.end(); ++it)
-		m_CloseSet.Insert(it->GetEndVertexNumber(), it->GetEdgeWeight());
+	G.ForEachEdge(u, [&](unsigned int target, double weight)
+	{
+		m_CloseSet.InsertIfPriorityLess(target, weight);
+	});
 
 	//  While we can find a path from u to v
 	while (!m_CloseSet.Empty())
@@ -544,40 +600,60 @@ double ShortestPathAlgorithm::GetShortestPathLength(const Graph& G, unsigned int
 		//  If this vertex is not in the open set (it equals there is no shorter path to this vertex)
 		if (!OpenSetContains(vertex))
 		{
-			m_OpenSet.push_back(vertex);
+			AddToOpenSet(vertex);
 
-			const list<Edge> & neighbors = G.GetNodeEdges(vertex);
-			for (auto it = neighbors.begin(); it != neighbors.end(); ++it)
+			G.ForEachEdge(vertex, [&](unsigned int target, double weight)
 			{
-				if (!OpenSetContains(it->GetEndVertexNumber()))
+				if (!OpenSetContains(target))
 				{
 					//  Inserting the vertex if it is not in the queue already or
 					//  if its weight is less than a weight of another path to this vertex
 					//  (i.e. this path is better than any prior paths to this vertex found)
-					m_CloseSet.InsertIfPriorityLess(it->GetEndVertexNumber(), priority + it->GetEdgeWeight());
+					m_CloseSet.InsertIfPriorityLess(target, priority + weight);
 				}
-			}
+			});
 		}
 	}
 
 	return -1;
 }
 
+double ShortestPathAlgorithm::GetShortestPathLength(const Graph &G, unsigned int u, unsigned int v)
+{
+	return ShortestPathLength(G, u, v);
+}
+
+double ShortestPathAlgorithm::GetShortestPathLength(const CompactGraph &G, unsigned int u, unsigned int v)
+{
+	//  A path from u to itself is the edge from u to u, the integer search doesn't look for it
+	IntegerShortestPathAlgorithm *integerAlgorithm = u != v ? GetIntegerAlgorithm(G) : nullptr;
+	if (integerAlgorithm)
+	{
+		double length = integerAlgorithm->GetShortestPathLength(G, u, v);
+		m_OpenSetSize = integerAlgorithm->GetSettledVertices();
+		return length;
+	}
+
+	return ShortestPathLength(G, u, v);
+}
+
 //  Get the AVERAGE of shortest paths from u to other vertices
 //  This method computes a shortest path from u to any vertex in the Graph
 //  Then it computes the average
-double ShortestPathAlgorithm::AverageShortestPath(const Graph &G, unsigned int u)
+template<typename TGraph>
+double ShortestPathAlgorithm::AverageShortestPathLength(const TGraph &G, unsigned int u)
 {
-	m_CloseSet = PriorityQueue<unsigned int, double>();
-	m_OpenSet.resize(0);
+	m_CloseSet.Reset(G.GetVerticesAmount());
+	ResetOpenSet(G.GetVerticesAmount());
 
 	double sum = 0.0;
-	const list<Edge> &firstVNeighbors = G.GetNodeEdges(u);
 	//  Add u to the open set
-	m_OpenSet.push_back(u);
+	AddToOpenSet(u);
 	//  Add all the neighboors of u to the close set
-	for (auto it = firstVNeighbors.begin(); it != firstVNeighbors.end(); ++it)
-		m_CloseSet.Insert(it->GetEndVertexNumber(), it->GetEdgeWeight());
+	G.ForEachEdge(u, [&](unsigned int target, double weight)
+	{
+		m_CloseSet.InsertIfPriorityLess(target, weight);
+	});
 
 	//  While we can find a path from u to v
 	while (!m_CloseSet.Empty())
@@ -590,79 +666,411 @@ double ShortestPathAlgorithm::AverageShortestPath(const Graph &G, unsigned int u
 		//  If this vertex is not in the open set (it equals there is no shorter path to this vertex)
 		if (!OpenSetContains(vertex))
 		{
-			m_OpenSet.push_back(vertex);
+			AddToOpenSet(vertex);
 			//  Add this weight to the sum
 			sum += priority;
 
-			const list<Edge> & neighbors = G.GetNodeEdges(vertex);
-			for (auto it = neighbors.begin(); it != neighbors.end(); ++it)
+			G.ForEachEdge(vertex, [&](unsigned int target, double weight)
 			{
-				if (!OpenSetContains(it->GetEndVertexNumber()))  //  1. find 2. second check
+				if (!OpenSetContains(target))  //  1. find 2. second check
 				{
 					//  Inserting the vertex if it is not in the queue already or
 					//  if its weight is less than a weight of another path to this vertex
 					//  (i.e. this path is better than any prior paths to this vertex found)
-					m_CloseSet.InsertIfPriorityLess(it->GetEndVertexNumber(), priority + it->GetEdgeWeight());
+					m_CloseSet.InsertIfPriorityLess(target, priority + weight);
 				}
-			}
+			});
 		}
 	}
 
-	if (m_OpenSet.size() > 1)
-		return sum / (m_OpenSet.size() - 1);
+	if (m_OpenSetSize > 1)
+		return sum / (m_OpenSetSize - 1);
 	else
 		return -1.0;
 }
 
+double ShortestPathAlgorithm::AverageShortestPath(const Graph &G, unsigned int u)
+{
+	return AverageShortestPathLength(G, u);
+}
+
+double ShortestPathAlgorithm::AverageShortestPath(const CompactGraph &G, unsigned int u)
+{
+	IntegerShortestPathAlgorithm *integerAlgorithm = GetIntegerAlgorithm(G);
+	if (integerAlgorithm)
+	{
+		double average = integerAlgorithm->AverageShortestPath(G, u);
+		m_OpenSetSize = integerAlgorithm->GetSettledVertices();
+		return average;
+	}
+
+	return AverageShortestPathLength(G, u);
+}
+
+//  Get the lengths of shortest paths from u to all the vertices. It is the search of AverageShortestPath
+//  that stores the length of every settled vertex
+template<typename TGraph>
+void ShortestPathAlgorithm::ShortestDistances(const TGraph &G, unsigned int u, vector<double> &distances)
+{
+	m_CloseSet.Reset(G.GetVerticesAmount());
+	ResetOpenSet(G.GetVerticesAmount());
+	distances.assign(G.GetVerticesAmount(), -1.0);
+
+	distances[u] = 0.0;
+	AddToOpenSet(u);
+	G.ForEachEdge(u, [&](unsigned int target, double weight)
+	{
+		m_CloseSet.InsertIfPriorityLess(target, weight);
+	});
+
+	while (!m_CloseSet.Empty())
+	{
+		unsigned int vertex = m_CloseSet.Top();
+		double priority = m_CloseSet.GetTopPriority();
+		m_CloseSet.Pop();
+
+		if (!OpenSetContains(vertex))
+		{
+			AddToOpenSet(vertex);
+			distances[vertex] = priority;
+
+			G.ForEachEdge(vertex, [&](unsigned int target, double weight)
+			{
+				if (!OpenSetContains(target))
+					m_CloseSet.InsertIfPriorityLess(target, priority + weight);
+			});
+		}
+	}
+}
+
+vector<double> ShortestPathAlgorithm::GetShortestDistances(const Graph &G, unsigned int u)
+{
+	vector<double> distances;
+	ShortestDistances(G, u, distances);
+	return distances;
+}
+
+vector<double> ShortestPathAlgorithm::GetShortestDistances(const CompactGraph &G, unsigned int u)
+{
+	IntegerShortestPathAlgorithm *integerAlgorithm = GetIntegerAlgorithm(G);
+	if (integerAlgorithm)
+	{
+		vector<double> distances = integerAlgorithm->GetShortestDistances(G, u);
+		m_OpenSetSize = integerAlgorithm->GetSettledVertices();
+		return distances;
+	}
+
+	vector<double> distances;
+	ShortestDistances(G, u, distances);
+	return distances;
+}
+
 //  Get Shortest PATH from u to v
-Path ShortestPathAlgorithm::GetShortestPath(const Graph &G, unsigned int u, unsigned int v)
+//  It is the search of GetShortestPathLength that also remembers the predecessor of every vertex in the close set.
+//  When v is reached the path is collected by following the predecessors from v back to u
+template<typename TGraph>
+Path ShortestPathAlgorithm::ShortestPath(const TGraph &G, unsigned int u, unsigned int v)
 {
-	m_PathCloseSet = PriorityQueue<Path, double>();
-	m_OpenSet.resize(0);
+	m_CloseSet.Reset(G.GetVerticesAmount());
+	ResetOpenSet(G.GetVerticesAmount());
+	if (m_Predecessor.size() < G.GetVerticesAmount())
+		m_Predecessor.resize(G.GetVerticesAmount());
 
-	Path currentPath(u);
-	const list<Edge> &firstVNeighbors = G.GetNodeEdges(u);
 	//  Add u to the open set
-	m_OpenSet.push_back(u);
+	AddToOpenSet(u);
 	//  Add all the neighboors of u to the close set
-	for (auto it = firstVNeighbors.begin(); it != firstVNeighbors.end(); ++it)
+	G.ForEachEdge(u, [&](unsigned int target, double weight)
 	{
-		Path nextPath(currentPath, *it);
-		m_PathCloseSet.Insert(nextPath, nextPath.GetWeight());
-	}
+		if (m_CloseSet.InsertIfPriorityLess(target, weight))
+			m_Predecessor[target] = u;
+	});
 
 	//  While we can find a path from u to v
-	while (!m_PathCloseSet.Empty())
+	while (!m_CloseSet.Empty())
 	{
-		//  Get the path with the best priority
-		currentPath = m_PathCloseSet.Top();
-		double priority = m_PathCloseSet.GetTopPriority();
-		m_PathCloseSet.Pop();
+		//  Get the vertex with the best weight
+		unsigned int vertex = m_CloseSet.Top();
+		double priority = m_CloseSet.GetTopPriority();
+		m_CloseSet.Pop();
+
+		//  If it is v we're over (Dijkstra algoritm guarantees this path's the shortest).
+		//  The loop runs at least once, so a path from u to itself is the edge from u to u
+		if (vertex == v)
+		{
+			list<unsigned int> path(1, v);
+			do
+			{
+				vertex = m_Predecessor[vertex];
+				path.push_front(vertex);
+			} while (vertex != u);
 
-		//  If it ends in v we're over (Dijkstra algoritm guarantees this path's the shortest)
-		if (currentPath.GetFinalVertex() == v)
-			return currentPath;
+			return Path(move(path), priority);
+		}
 
 		//  If this vertex is not in the open set (it equals there is no shorter path to this vertex)
-		if (!OpenSetContains(currentPath.GetFinalVertex()))
+		if (!OpenSetContains(vertex))
 		{
-			//  Add vertex to the open set
-			m_OpenSet.push_back(currentPath.GetFinalVertex());
+			AddToOpenSet(vertex);
 
-			const list<Edge> & neighbors = G.GetNodeEdges(currentPath.GetFinalVertex());
-			for (auto it = neighbors.begin(); it != neighbors.end(); ++it)
+			G.ForEachEdge(vertex, [&](unsigned int target, double weight)
 			{
-				if (!OpenSetContains(it->GetEndVertexNumber()))
+				//  Remember where the path comes from if it is better than any prior path to this vertex
+				if (!OpenSetContains(target) && m_CloseSet.InsertIfPriorityLess(target, priority + weight))
+					m_Predecessor[target] = vertex;
+			});
+		}
+	}
+
+	return Path(u);
+}
+
+Path ShortestPathAlgorithm::GetShortestPath(const Graph &G, unsigned int u, unsigned int v)
+{
+	return ShortestPath(G, u, v);
+}
+
+Path ShortestPathAlgorithm::GetShortestPath(const CompactGraph &G, unsigned int u, unsigned int v)
+{
+	return ShortestPath(G, u, v);
+}
+
+template<typename TGraph>
+double ShortestPathAlgorithm::SelfLoopLength(const TGraph &G, unsigned int u)
+{
+	double length = -1.0;
+	G.ForEachEdge(u, [&](unsigned int target, double weight)
+	{
+		if (target == u && (length < 0.0 || weight < length))
+			length = weight;
+	});
+	return length;
+}
+
+//  Dijkstra searches from u on G and from v on the reversed graph, every step is made by the search with the nearer
+//  vertex on the top of its close set. Every scanned edge that leads to a vertex reached by the other search gives a path
+//  from u to v. The search stops when the tops of both close sets together are not less than the best path found,
+//  no path through an unsettled vertex can be shorter then
+template<typename TGraph>
+double ShortestPathAlgorithm::BidirectionalPathLength(const TGraph &G, const TGraph &reversed, unsigned int u, unsigned int v)
+{
+	const unsigned int NO_VERTEX = UINT_MAX;
+	double best = DBL_MAX, bestWeight = 0.0;
+	unsigned int bestFrom = NO_VERTEX, bestTo = NO_VERTEX;
+
+	m_CloseSet.Reset(G.GetVerticesAmount());
+	m_BackwardCloseSet.Reset(G.GetVerticesAmount());
+	ResetOpenSet(G.GetVerticesAmount());
+	ReserveSearchArrays(G.GetVerticesAmount());
+
+	if (u == v)
+		return SelfLoopLength(G, u);
+
+	m_Reached[u] = m_Stamp;
+	m_Distance[u] = 0.0;
+	m_CloseSet.Insert(u, 0.0);
+	m_BackwardReached[v] = m_Stamp;
+	m_BackwardDistance[v] = 0.0;
+	m_BackwardCloseSet.Insert(v, 0.0);
+
+	while (!m_CloseSet.Empty() && !m_BackwardCloseSet.Empty())
+	{
+		double forwardTop = m_CloseSet.GetTopPriority();
+		double backwardTop = m_BackwardCloseSet.GetTopPriority();
+		if (forwardTop + backwardTop >= best)
+			break;
+
+		if (forwardTop <= backwardTop)
+		{
+			unsigned int vertex = m_CloseSet.Top();
+			m_CloseSet.Pop();
+			AddToOpenSet(vertex);
+
+			G.ForEachEdge(vertex, [&](unsigned int target, double weight)
+			{
+				double distance = forwardTop + weight;
+				if (!OpenSetContains(target) && (m_Reached[target] != m_Stamp || distance < m_Distance[target]))
 				{
-					//  Inserting the path if it is not in the queue already or
-					//  if its weight is less than a weight of another path to this vertex
-					//  (i.e. this path is better than any prior paths to this vertex found)
-					Path nextPath(currentPath, *it);
-					m_PathCloseSet.InsertIfPriorityLess(nextPath, nextPath.GetWeight());
+					m_Reached[target] = m_Stamp;
+					m_Distance[target] = distance;
+					m_CloseSet.InsertIfPriorityLess(target, distance);
 				}
-			}
+				if (m_BackwardReached[target] == m_Stamp && distance + m_BackwardDistance[target] < best)
+				{
+					best = distance + m_BackwardDistance[target];
+					bestFrom = vertex;
+					bestTo = target;
+					bestWeight = weight;
+				}
+			});
+		}
+		else
+		{
+			//  An edge from vertex to target of the reversed graph is the edge from target to vertex of G
+			unsigned int vertex = m_BackwardCloseSet.Top();
+			m_BackwardCloseSet.Pop();
+			m_BackwardOpenSet[vertex] = m_Stamp;
+			m_BackwardOpenSetSize++;
+
+			reversed.ForEachEdge(vertex, [&](unsigned int target, double weight)
+			{
+				double distance = backwardTop + weight;
+				if (m_BackwardOpenSet[target] != m_Stamp && (m_BackwardReached[target] != m_Stamp || distance < m_BackwardDistance[target]))
+				{
+					m_BackwardReached[target] = m_Stamp;
+					m_BackwardDistance[target] = distance;
+					m_BackwardPredecessor[target] = vertex;
+					m_BackwardWeight[target] = weight;
+					m_BackwardCloseSet.InsertIfPriorityLess(target, distance);
+				}
+				if (m_Reached[target] == m_Stamp && distance + m_Distance[target] < best)
+				{
+					best = distance + m_Distance[target];
+					bestFrom = target;
+					bestTo = vertex;
+					bestWeight = weight;
+				}
+			});
 		}
 	}
 
-	return Path(u);
-}
\ No newline at end of file
+	if (bestFrom == NO_VERTEX)
+		return -1;
+
+	//  The length is summed again from u to v, in the order GetShortestPathLength sums it,
+	//  so both of them give exactly the same double. The forward length is already summed in this order
+	double length = m_Distance[bestFrom] + bestWeight;
+	for (unsigned int vertex = bestTo; vertex != v; vertex = m_BackwardPredecessor[vertex])
+		length += m_BackwardWeight[vertex];
+
+	return length;
+}
+
+double ShortestPathAlgorithm::GetShortestPathLengthBidirectional(const Graph &G, const Graph &reversed, unsigned int u, unsigned int v)
+{
+	return BidirectionalPathLength(G, reversed, u, v);
+}
+
+double ShortestPathAlgorithm::GetShortestPathLengthBidirectional(const CompactGraph &G, const CompactGraph &reversed, unsigned int u,
+	unsigned int v)
+{
+	return BidirectionalPathLength(G, reversed, u, v);
+}
+
+//  The close set keeps the length of a path plus the estimate of the rest of it. An admissible heuristic that
+//  is not consistent can find a shorter path to an expanded vertex later, then the vertex is expanded again
+template<typename TGraph>
+double ShortestPathAlgorithm::AStarPathLength(const TGraph &G, unsigned int u, unsigned int v, const IDistanceHeuristic &heuristic)
+{
+	m_CloseSet.Reset(G.GetVerticesAmount());
+	ResetOpenSet(G.GetVerticesAmount());
+	ReserveSearchArrays(G.GetVerticesAmount());
+
+	if (u == v)
+		return SelfLoopLength(G, u);
+
+	m_Reached[u] = m_Stamp;
+	m_Distance[u] = 0.0;
+	m_CloseSet.Insert(u, heuristic.GetEstimate(u, v));
+
+	while (!m_CloseSet.Empty())
+	{
+		unsigned int vertex = m_CloseSet.Top();
+		double distance = m_Distance[vertex];
+		m_CloseSet.Pop();
+
+		if (vertex == v)
+			return distance;
+
+		m_OpenSetSize++;
+		G.ForEachEdge(vertex, [&](unsigned int target, double weight)
+		{
+			if (m_Reached[target] != m_Stamp || distance + weight < m_Distance[target])
+			{
+				m_Reached[target] = m_Stamp;
+				m_Distance[target] = distance + weight;
+				m_CloseSet.InsertIfPriorityLess(target, distance + weight + heuristic.GetEstimate(target, v));
+			}
+		});
+	}
+
+	return -1;
+}
+
+double ShortestPathAlgorithm::GetShortestPathLengthAStar(const Graph &G, unsigned int u, unsigned int v, const IDistanceHeuristic &heuristic)
+{
+	return AStarPathLength(G, u, v, heuristic);
+}
+
+double ShortestPathAlgorithm::GetShortestPathLengthAStar(const CompactGraph &G, unsigned int u, unsigned int v,
+	const IDistanceHeuristic &heuristic)
+{
+	return AStarPathLength(G, u, v, heuristic);
+}
+
+template<typename TGraph>
+vector<double> ShortestPathAlgorithm::AverageShortestPaths(const TGraph &G, const vector<unsigned int> &sources, unsigned int threads)
+{
+	//  Sources are taken by small blocks, the searches from different vertices can take very different time
+	const unsigned int block = 16;
+	vector<double> averages(sources.size(), -1.0);
+	atomic<unsigned int> next(0);
+
+	threads = std::max(1u, std::min<unsigned int>(GetThreadCount(threads), (sources.size() + block - 1) / block));
+
+	auto worker = [&](unsigned int)
+	{
+		ShortestPathAlgorithm algorithm;
+		for (unsigned int first = next.fetch_add(block); first < sources.size(); first = next.fetch_add(block))
+			for (unsigned int i = first; i < first + block && i < sources.size(); ++i)
+				averages[i] = algorithm.AverageShortestPath(G, sources[i]);
+	};
+
+	RunThreads(threads, worker);
+
+	return averages;
+}
+
+//  All the vertices as the sources
+static vector<unsigned int> GetAllVertices(unsigned int size)
+{
+	vector<unsigned int> vertices(size);
+	for (unsigned int v = 0; v < size; ++v)
+		vertices[v] = v;
+	return vertices;
+}
+
+vector<double> ShortestPathAlgorithm::GetAverageShortestPaths(const Graph &G, unsigned int threads /* = 0 */)
+{
+	return AverageShortestPaths(G, GetAllVertices(G.GetVerticesAmount()), threads);
+}
+
+vector<double> ShortestPathAlgorithm::GetAverageShortestPaths(const Graph &G, const vector<unsigned int> &sources, unsigned int threads /* = 0 */)
+{
+	return AverageShortestPaths(G, sources, threads);
+}
+
+vector<double> ShortestPathAlgorithm::GetAverageShortestPaths(const CompactGraph &G, unsigned int threads /* = 0 */)
+{
+	return AverageShortestPaths(G, GetAllVertices(G.GetVerticesAmount()), threads);
+}
+
+vector<double> ShortestPathAlgorithm::GetAverageShortestPaths(const CompactGraph &G, const vector<unsigned int> &sources, unsigned int threads /* = 0 */)
+{
+	return AverageShortestPaths(G, sources, threads);
+}
+
+double ShortestPathAlgorithm::GetMean(const vector<double> &averages)
+{
+	double sum = 0.0;
+	unsigned int count = 0;
+
+	//  Always summed in the same order, so the result is the same for any number of threads
+	for (auto it = averages.begin(); it != averages.end(); ++it)
+		if (*it >= 0.0)
+		{
+			sum += *it;
+			count++;
+		}
+
+	return count > 0 ? sum / count : -1.0;
+}
@@ -4,6 +4,8 @@
 #define GRAPH_H__
 
 #include "PriorityQueue.h"
+#include <climits>
+#include <cfloat>
 #include <cstdlib>
 #include <ctime>
 #include <vector>
@@ -11,6 +13,9 @@
 #include <utility>
 #include <string>
 #include <fstream>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 using std::move;
 using std::vector;
@@ -19,10 +24,15 @@ using std::pair;
 using std::string;
 using std::ifstream;
 using std::ios_base;
+using std::thread;
+using std::atomic;
+using std::unique_ptr;
 
 double GenerateRandomDouble(double dMin, double dMax);
 
 class Edge;
+class CompactGraph;
+class IntegerShortestPathAlgorithm;
 
 enum PlayerColor{NONE, RED, BLUE};
 
@@ -35,9 +45,13 @@ private:
 public:
 	Vertex();
 	Vertex(unsigned int vertexNumber);
+	Vertex(const Vertex &vertex);
 	Vertex(Vertex &&vertex);
 	~Vertex();
 
+	Vertex &operator=(const Vertex &vertex);
+	Vertex &operator=(Vertex &&vertex);
+
 	bool Adjacent(unsigned int v2) const;
 	double GetEdgeValue(unsigned int v2) const;
 	PlayerColor GetColor() const;
@@ -51,6 +65,7 @@ public:
 	void SetEdgeValue(unsigned int v2, double value);
 	void SetVertexNumber(unsigned int number);
 	bool SetVertexColor(PlayerColor playerColor);
+	void ResetVertexColor();
 };
 
 //  This class implements an Edge TO a vertex with a given weight.
@@ -68,9 +83,13 @@ public:
 	Edge();
 	Edge(unsigned int startVertex, unsigned int endVertex, double weight, PlayerColor playerColor = NONE);
 	Edge(unsigned int startVertex, unsigned int endVertex, PlayerColor playerColor = NONE);
+	Edge(const Edge &edge);
 	Edge(Edge && edge);
 	~Edge();
 
+	Edge &operator=(const Edge &edge);
+	Edge &operator=(Edge &&edge);
+
 	//  Getters
 	unsigned int GetStartVertexNumber() const;
 	unsigned int GetEndVertexNumber() const;
@@ -98,13 +117,24 @@ public:
 	//  ranging from distance_min to distance_max
 	//  This constructor is used instead of a generation procedure from the assignment details
 	Graph(unsigned int size, double density, double distance_min, double distance_max);
-	//  Read graph from a file
+	//  Build the graph of the given size from the arrays of the start vertices, the end vertices, the weights and the colors
+	//  of its edges, the edges have no color if the colors are not given. Edges are added in the order of the arrays without
+	//  looking for the same edge. Edges with a vertex out of range are skipped
+	Graph(unsigned int size, const vector<unsigned int> &sources, const vector<unsigned int> &targets, const vector<double> &weights,
+		const vector<PlayerColor> &colors = vector<PlayerColor>());
+	//  Read graph from a file of any format GraphLoader reads. If the file can't be loaded, the error of GraphLoader
+	//  (with the line of a malformed file) is written to cerr and the graph is empty. Use GraphLoader to get the error
 	Graph(const string &filename);
+	//  Copy graph
+	Graph(const Graph &graph);
 	//  Move graph
 	Graph(Graph &&graph);
 	//  The destructor
 	~Graph();
 
+	Graph &operator=(const Graph &graph);
+	Graph &operator=(Graph &&graph);
+
 	//  Get number of vertices in the Graph
 	unsigned int GetVerticesAmount() const;
 	//  Get the number of edges between vertices in the Graph
@@ -125,6 +155,8 @@ public:
 	void SetEdgeValue(unsigned int v1, unsigned int v2, double value);
 	//  Set the color of a vertex
 	bool SetVertexColor(unsigned int v, PlayerColor playerColor);
+	//  Make a vertex uncolored again
+	void ResetVertexColor(unsigned int v);
 	//  Set the color of an edge
 	bool SetEdgeColor(unsigned int v1, unsigned int v2, PlayerColor playerColor);
 	//  Add an edge to the Graph
@@ -134,11 +166,23 @@ public:
 	void AddEdge(const Edge& edge);
 	//  Delete an edge from the Graph
 	void DeleteEdge(unsigned int v1, unsigned int v2);
-	//  Prim's algorithm. A tree is a graph so the result is of the Graph class
+	//  Prim's algorithm (see MinimumSpanningTreeAlgorithm). A tree is a graph so the result is of the Graph class
 	Graph PrimMST(double &length);
 
 	//  Get list of the vertices we can get to form a given vertex
 	list<unsigned int> GetConnections(unsigned int v);
+	//  Get the graph with the same vertices and all the edges reversed (an edge from v2 to v1 for every edge from v1 to v2)
+	Graph GetReversed() const;
+
+	//  Call function(target, weight) for every edge of the vertex v. CompactGraph has the same method,
+	//  so an algorithm written as a template works on both of them
+	template<typename TFunction>
+	void ForEachEdge(unsigned int v, TFunction function) const
+	{
+		const list<Edge> &edges = m_Vertices[v].GetNodeEdges();
+		for (auto it = edges.begin(); it != edges.end(); ++it)
+			function(it->GetEndVertexNumber(), it->GetEdgeWeight());
+	}
 };
 
 //  This class implements a path on the Graph
@@ -156,6 +200,8 @@ public:
 	Path(const Path &path);
 	//  Copy a path and add an edge to it (continue path)
 	Path(const Path &path, const Edge &edge);
+	//  Take the list of vertices of a path and its weight
+	Path(list<unsigned int> &&path, double weight);
 
 	//  Get the path itself
 	const list<unsigned int> &GetPath() const;
@@ -171,35 +217,134 @@ public:
 	void AddVertex(const Edge &edge);
 };
 
+//  Interface of a lower bound of the shortest path length between two vertices, it is used by the A* search.
+//  An estimate must never be more than the real length (it is admissible), otherwise A* can return a longer path
+class IDistanceHeuristic
+{
+public:
+	virtual ~IDistanceHeuristic() {}
+	virtual double GetEstimate(unsigned int from, unsigned int to) const = 0;
+};
+
 //  This class implements Dijkstra shortest path algorithm.
 
-//  It stores a priority queue of vertices with their weight as the close set to find shortest path length
-//  and a priority queue of paths to get the shortest path itself (Path class)
-//  It stores the list of vertices and their respectful weights as the open set.
+//  It stores an indexed priority queue of vertices with their weight as the close set to find shortest path length.
+//  The shortest path itself (Path class) is built once at the end from the predecessor of every reached vertex,
+//  so the search doesn't copy paths
+//  The open set of the settled vertices is an array of the size of the Graph with a search stamp for every vertex:
+//  a vertex is in the open set if its stamp equals the stamp of the current search. So the check is O(1) and a new search
+//  only increments the stamp instead of clearing the array. The arrays are kept between the calls and grow with the Graph
+//  A vertex is in the indexed queue only once, a shorter path to it decreases its weight in O(log n)
 
 //  This class has 3 different methods to get the Shortest Path Length, the Average Shortest Path Length and
 //  the Shortest Path. Implementation of all of them differs a little because of the performance issues
 //  For example, tests have shown that using this implementation of the average path length calculation gives more than 20%
 //  of speed upgrade compared to the method of calling GetShortestPathLength for u and each vertex in the Graph
+
+//  Every method works on a Graph and on its CompactGraph snapshot. Both of them give the same results,
+//  the snapshot is faster on large graphs
 class ShortestPathAlgorithm
 {
 private:
 	vector<unsigned int> m_OpenSet;
-	PriorityQueue<unsigned int, double> m_CloseSet;
-	PriorityQueue<Path, double> m_PathCloseSet;
+	unsigned int m_Stamp;
+	unsigned int m_OpenSetSize;
+	IndexedPriorityQueue<double> m_CloseSet;
+	//  The vertex before the given one on the best path found to it. Valid only for the vertices reached by the current search
+	vector<unsigned int> m_Predecessor;
+	//  Lengths of the best paths found to the vertices whose m_Reached stamp is the current one. They are used by
+	//  the A* and bidirectional searches, because the close set of A* keeps estimates instead of lengths
+	vector<double> m_Distance;
+	vector<unsigned int> m_Reached;
+	//  The backward half of the bidirectional search from v on the reversed graph. m_BackwardPredecessor is the next
+	//  vertex on the path to v and m_BackwardWeight is the weight of the edge to it
+	vector<unsigned int> m_BackwardOpenSet;
+	unsigned int m_BackwardOpenSetSize;
+	IndexedPriorityQueue<double> m_BackwardCloseSet;
+	vector<double> m_BackwardDistance;
+	vector<unsigned int> m_BackwardReached;
+	vector<unsigned int> m_BackwardPredecessor;
+	vector<double> m_BackwardWeight;
+	//  The search for a CompactGraph with integer weights, it is created when it is needed for the first time
+	unique_ptr<IntegerShortestPathAlgorithm> m_IntegerAlgorithm;
+	bool m_bIntegerSearch;
 
+	//  Make the open set empty for a search on a graph of the given size
+	void ResetOpenSet(unsigned int size);
+	//  Grow the arrays of the A* and bidirectional searches to the given size
+	void ReserveSearchArrays(unsigned int size);
+	//  Get the integer search if it is enabled and can search the graph, nullptr otherwise
+	IntegerShortestPathAlgorithm *GetIntegerAlgorithm(const CompactGraph &G);
 	//  Check if the vertex is already is in the open set
-	bool OpenSetContains(unsigned int vertex) const;
+	bool OpenSetContains(unsigned int vertex) const { return m_OpenSet[vertex] == m_Stamp; }
+	void AddToOpenSet(unsigned int vertex)
+	{
+		m_OpenSet[vertex] = m_Stamp;
+		m_OpenSetSize++;
+	}
+
+	//  Implementations of the public methods for both types of graphs
+	template<typename TGraph>
+	Path ShortestPath(const TGraph &G, unsigned int u, unsigned int v);
+	template<typename TGraph>
+	double ShortestPathLength(const TGraph &G, unsigned int u, unsigned int v);
+	template<typename TGraph>
+	double AverageShortestPathLength(const TGraph &G, unsigned int u);
+	template<typename TGraph>
+	void ShortestDistances(const TGraph &G, unsigned int u, vector<double> &distances);
+	template<typename TGraph>
+	double BidirectionalPathLength(const TGraph &G, const TGraph &reversed, unsigned int u, unsigned int v);
+	template<typename TGraph>
+	double AStarPathLength(const TGraph &G, unsigned int u, unsigned int v, const IDistanceHeuristic &heuristic);
+	//  The length of the path from u to u that GetShortestPathLength returns: the lightest edge from u to itself, -1 if there is none
+	template<typename TGraph>
+	static double SelfLoopLength(const TGraph &G, unsigned int u);
+	template<typename TGraph>
+	static vector<double> AverageShortestPaths(const TGraph &G, const vector<unsigned int> &sources, unsigned int threads);
 public:
 	ShortestPathAlgorithm();
 	~ShortestPathAlgorithm();
 
 	//  Get the shortest Path from the vertex u to the vertex v on the Graph G
 	Path GetShortestPath(const Graph &G, unsigned int u, unsigned int v);
+	Path GetShortestPath(const CompactGraph &G, unsigned int u, unsigned int v);
 	//  Get the shortest Path Length from the vertex u to the vertex v on the Graph G
 	double GetShortestPathLength(const Graph& G, unsigned int u, unsigned int v);
+	double GetShortestPathLength(const CompactGraph &G, unsigned int u, unsigned int v);
 	//  Get the average shortest Path Length of the v u of the Graph G
 	double AverageShortestPath(const Graph &G, unsigned int u);
+	double AverageShortestPath(const CompactGraph &G, unsigned int u);
+	//  Get the shortest Path Lengths from the vertex u to all the vertices of the Graph G in one search.
+	//  The length to u is 0, the length to a vertex that can't be reached is -1
+	vector<double> GetShortestDistances(const Graph &G, unsigned int u);
+	vector<double> GetShortestDistances(const CompactGraph &G, unsigned int u);
+	//  Get the shortest Path Length from u to v searching from both of them at once: forward from u on G and backward
+	//  from v on the reversed graph (see GetReversed, an undirected graph is the reversed graph of itself).
+	//  The result is the same as of GetShortestPathLength, but a lot less vertices are settled on a big graph
+	double GetShortestPathLengthBidirectional(const Graph &G, const Graph &reversed, unsigned int u, unsigned int v);
+	double GetShortestPathLengthBidirectional(const CompactGraph &G, const CompactGraph &reversed, unsigned int u, unsigned int v);
+	//  Get the shortest Path Length from u to v with the A* search directed to v by the heuristic.
+	//  The result is the same as of GetShortestPathLength if the heuristic is admissible
+	double GetShortestPathLengthAStar(const Graph &G, unsigned int u, unsigned int v, const IDistanceHeuristic &heuristic);
+	double GetShortestPathLengthAStar(const CompactGraph &G, unsigned int u, unsigned int v, const IDistanceHeuristic &heuristic);
+	//  The number of the vertices settled (expanded) by the last search, in both directions for the bidirectional one
+	unsigned int GetSettledVertices() const { return m_OpenSetSize + m_BackwardOpenSetSize; }
+	//  GetShortestPathLength, AverageShortestPath and GetShortestDistances of a CompactGraph whose weights are small
+	//  non-negative integers use IntegerShortestPathAlgorithm instead of the heap. It is enabled by default
+	bool GetIntegerSearch() const { return m_bIntegerSearch; }
+	void SetIntegerSearch(bool bIntegerSearch) { m_bIntegerSearch = bIntegerSearch; }
+
+	//  Get AverageShortestPath of every vertex of the Graph G, or of every vertex of sources. The result i is the average
+	//  of the vertex i (of sources[i]). The sources are shared between the threads, every thread has its own
+	//  ShortestPathAlgorithm and writes only the results of its sources, so the result doesn't depend on the threads.
+	//  threads == 0 means one thread per hardware core
+	static vector<double> GetAverageShortestPaths(const Graph &G, unsigned int threads = 0);
+	static vector<double> GetAverageShortestPaths(const Graph &G, const vector<unsigned int> &sources, unsigned int threads = 0);
+	static vector<double> GetAverageShortestPaths(const CompactGraph &G, unsigned int threads = 0);
+	static vector<double> GetAverageShortestPaths(const CompactGraph &G, const vector<unsigned int> &sources, unsigned int threads = 0);
+	//  The mean of the averages in their order, the averages of -1 (no path from the vertex) are skipped.
+	//  Returns -1 if there are no paths at all
+	static double GetMean(const vector<double> &averages);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,470 @@
+///  Contains the parallel text graph loader implementation
+#include "GraphLoader.h"
+#include "Threads.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::to_string;
+
+//  Files are read by blocks of this size, and a thread gets at least this much of the text
+static const size_t BLOCK_SIZE = 1 << 24;
+static const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+//  Powers of ten that are exact doubles
+static const double POWERS_OF_TEN[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline bool IsBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static inline const char *SkipBlanks(const char *p, const char *end)
+{
+	while (p < end && IsBlank(*p))
+		++p;
+	return p;
+}
+
+//  A number must be followed by a blank or the end of the line
+static inline bool IsTokenEnd(const char *p, const char *end)
+{
+	return p == end || IsBlank(*p);
+}
+
+static inline const char *FindLineEnd(const char *p, const char *end)
+{
+	const char *lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+	return lineEnd != nullptr ? lineEnd : end;
+}
+
+static bool ScanUnsigned(const char *&p, const char *end, unsigned int &value)
+{
+	const char *start = p;
+	unsigned long long number = 0;
+
+	for (; p < end && IsDigit(*p); ++p)
+	{
+		number = number * 10 + (*p - '0');
+		if (number > UINT_MAX)
+			return false;
+	}
+
+	value = static_cast<unsigned int>(number);
+	return p != start && IsTokenEnd(p, end);
+}
+
+//  A decimal number of not more than 15 significant digits and a small exponent is the exact integer mantissa
+//  multiplied or divided by the exact power of ten, so the result is rounded once, as strtod rounds it.
+//  Other numbers go to strtod
+static bool ScanDouble(const char *&p, const char *end, double &value)
+{
+	const char *start = p;
+	bool bNegative = false;
+	bool bDigits = false;
+	bool bExact = true;
+	unsigned long long mantissa = 0;
+	int digits = 0, exponent = 0;
+
+	if (p < end && (*p == '-' || *p == '+'))
+		bNegative = *p++ == '-';
+
+	for (bool bFraction = false; p < end; ++p)
+	{
+		if (*p == '.' && !bFraction)
+		{
+			bFraction = true;
+			continue;
+		}
+		if (!IsDigit(*p))
+			break;
+
+		bDigits = true;
+		if (bFraction)
+			exponent--;
+		if (mantissa == 0 && *p == '0')
+			continue;
+		if (++digits > 15)
+			bExact = false;
+		else
+			mantissa = mantissa * 10 + (*p - '0');
+	}
+	if (!bDigits)
+		return false;
+
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		int sign = 1, power = 0;
+		++p;
+		if (p < end && (*p == '-' || *p == '+'))
+			sign = *p++ == '-' ? -1 : 1;
+		if (p == end || !IsDigit(*p))
+			return false;
+		for (; p < end && IsDigit(*p); ++p)
+			power = std::min(power * 10 + (*p - '0'), 100000);
+		exponent += sign * power;
+	}
+	if (!IsTokenEnd(p, end))
+		return false;
+
+	if (bExact && exponent >= -22 && exponent <= 22)
+	{
+		value = exponent < 0 ? mantissa / POWERS_OF_TEN[-exponent] : mantissa * POWERS_OF_TEN[exponent];
+		if (bNegative)
+			value = -value;
+	}
+	else
+	{
+		string token(start, p);
+		value = strtod(token.c_str(), nullptr);
+	}
+	return true;
+}
+
+GraphLoader::GraphLoader(unsigned int threads /* = 0 */) : m_Threads(0), m_Format(AUTO_FORMAT), m_Size(0), m_Bytes(0), m_Seconds(0.0)
+{
+	SetThreads(threads);
+}
+
+GraphLoader::~GraphLoader()
+{
+}
+
+void GraphLoader::SetThreads(unsigned int threads)
+{
+	m_Threads = GetThreadCount(threads);
+}
+
+void GraphLoader::Clear()
+{
+	m_Format = AUTO_FORMAT;
+	m_Size = 0;
+	vector<unsigned int>().swap(m_Sources);
+	vector<unsigned int>().swap(m_Targets);
+	vector<double>().swap(m_Weights);
+	m_Error.clear();
+	m_Bytes = 0;
+	m_Seconds = 0.0;
+}
+
+bool GraphLoader::Fail(const string &error)
+{
+	string message = error;
+
+	Clear();
+	m_Error = message;
+	return false;
+}
+
+GraphFileFormat GraphLoader::DetectFormat(const char *begin, const char *end)
+{
+	for (const char *line = begin; line < end; )
+	{
+		const char *lineEnd = FindLineEnd(line, end);
+		const char *p = SkipBlanks(line, lineEnd);
+		line = lineEnd < end ? lineEnd + 1 : end;
+		if (p == lineEnd)
+			continue;
+
+		if (*p == 'c' || *p == 'p' || *p == 'a')
+			return DIMACS_FORMAT;
+		if (*p == '#' || *p == '%')
+			return EDGE_LIST_FORMAT;
+
+		//  Only the number of vertices is alone on its line
+		unsigned int tokens = 0;
+		while (p < lineEnd)
+		{
+			tokens++;
+			while (p < lineEnd && !IsBlank(*p))
+				++p;
+			p = SkipBlanks(p, lineEnd);
+		}
+		return tokens == 1 ? HEX_FORMAT : EDGE_LIST_FORMAT;
+	}
+
+	return HEX_FORMAT;
+}
+
+bool GraphLoader::ParseHeader(const char *&begin, const char *end, size_t &lines, size_t &edges)
+{
+	lines = 0;
+	edges = SIZE_MAX;
+	if (m_Format == EDGE_LIST_FORMAT)
+		return true;
+
+	while (begin < end)
+	{
+		const char *lineEnd = FindLineEnd(begin, end);
+		const char *p = SkipBlanks(begin, lineEnd);
+		lines++;
+		begin = lineEnd < end ? lineEnd + 1 : end;
+
+		if (p == lineEnd)
+			continue;
+
+		if (m_Format == HEX_FORMAT)
+		{
+			if (!ScanUnsigned(p, lineEnd, m_Size) || SkipBlanks(p, lineEnd) != lineEnd)
+			{
+				m_Error = "line " + to_string(lines) + ": expected the number of vertices";
+				return false;
+			}
+			return true;
+		}
+
+		//  DIMACS comments and the problem line "p sp vertices arcs"
+		if (*p == 'c')
+			continue;
+		unsigned int arcs = 0;
+		if (*p != 'p' || !IsTokenEnd(p + 1, lineEnd))
+		{
+			m_Error = "line " + to_string(lines) + ": expected the problem line \"p sp vertices arcs\"";
+			return false;
+		}
+		p = SkipBlanks(p + 1, lineEnd);
+		if (lineEnd - p < 2 || p[0] != 's' || p[1] != 'p' || !IsTokenEnd(p + 2, lineEnd))
+		{
+			m_Error = "line " + to_string(lines) + ": the problem is not \"sp\"";
+			return false;
+		}
+		p = SkipBlanks(p + 2, lineEnd);
+		if (!ScanUnsigned(p, lineEnd, m_Size))
+		{
+			m_Error = "line " + to_string(lines) + ": expected the number of vertices";
+			return false;
+		}
+		p = SkipBlanks(p, lineEnd);
+		if (!ScanUnsigned(p, lineEnd, arcs) || SkipBlanks(p, lineEnd) != lineEnd)
+		{
+			m_Error = "line " + to_string(lines) + ": expected the number of arcs";
+			return false;
+		}
+		edges = arcs;
+		return true;
+	}
+
+	m_Error = m_Format == HEX_FORMAT ? "the file has no number of vertices" : "the file has no problem line";
+	return false;
+}
+
+bool GraphLoader::ParseLine(const char *begin, const char *end, Chunk &chunk) const
+{
+	const char *p = SkipBlanks(begin, end);
+	unsigned int source, target;
+	double weight = 1.0;
+
+	if (p == end)
+		return true;
+
+	if (m_Format == DIMACS_FORMAT)
+	{
+		if (*p == 'c')
+			return true;
+		if (*p != 'a' || !IsTokenEnd(p + 1, end))
+		{
+			chunk.m_Error = *p == 'p' ? "the second problem line" : "expected an arc line \"a v1 v2 length\"";
+			return false;
+		}
+		p++;
+	}
+	else if (m_Format == EDGE_LIST_FORMAT && (*p == '#' || *p == '%'))
+		return true;
+
+	p = SkipBlanks(p, end);
+	if (!ScanUnsigned(p, end, source))
+	{
+		chunk.m_Error = "expected the number of the first vertex";
+		return false;
+	}
+	p = SkipBlanks(p, end);
+	if (!ScanUnsigned(p, end, target))
+	{
+		chunk.m_Error = "expected the number of the second vertex";
+		return false;
+	}
+	p = SkipBlanks(p, end);
+	//  The length can be omitted only in an edge list
+	if ((p < end || m_Format != EDGE_LIST_FORMAT) && !ScanDouble(p, end, weight))
+	{
+		chunk.m_Error = "expected the length of the edge";
+		return false;
+	}
+	if (SkipBlanks(p, end) != end)
+	{
+		chunk.m_Error = "unexpected text after the edge";
+		return false;
+	}
+
+	//  DIMACS vertices are numbered from 1, the error tells the number of the file
+	unsigned int first = m_Format == DIMACS_FORMAT ? 1 : 0;
+	if (m_Format != EDGE_LIST_FORMAT)
+	{
+		if (source < first || target < first || source - first >= m_Size || target - first >= m_Size)
+		{
+			unsigned int vertex = source < first || source - first >= m_Size ? source : target;
+			chunk.m_Error = "vertex " + to_string(vertex) + " is out of range, the graph has " + to_string(m_Size) + " vertices";
+			return false;
+		}
+		source -= first;
+		target -= first;
+	}
+	else if (source == UINT_MAX || target == UINT_MAX)
+	{
+		chunk.m_Error = "vertex number is too big";
+		return false;
+	}
+
+	chunk.m_Sources.push_back(source);
+	chunk.m_Targets.push_back(target);
+	chunk.m_Weights.push_back(weight);
+	chunk.m_MaxVertex = std::max(chunk.m_MaxVertex, std::max(source, target));
+	return true;
+}
+
+void GraphLoader::ParseChunk(Chunk &chunk) const
+{
+	//  An edge line has at least 6 characters, "0 1 1\n"
+	size_t lines = (chunk.m_End - chunk.m_Begin) / 6 + 1;
+	chunk.m_Sources.reserve(lines);
+	chunk.m_Targets.reserve(lines);
+	chunk.m_Weights.reserve(lines);
+
+	for (const char *line = chunk.m_Begin; line < chunk.m_End; )
+	{
+		const char *lineEnd = FindLineEnd(line, chunk.m_End);
+		chunk.m_Lines++;
+		if (!ParseLine(line, lineEnd, chunk))
+		{
+			chunk.m_ErrorLine = chunk.m_Lines;
+			return;
+		}
+		line = lineEnd + 1;
+	}
+}
+
+bool GraphLoader::Parse(const char *begin, const char *end, GraphFileFormat format /* = AUTO_FORMAT */)
+{
+	steady_clock::time_point start = steady_clock::now();
+	size_t headerLines, headerEdges;
+
+	Clear();
+	m_Bytes = end - begin;
+	m_Format = format != AUTO_FORMAT ? format : DetectFormat(begin, end);
+	if (!ParseHeader(begin, end, headerLines, headerEdges))
+		return Fail(m_Error);
+
+	//  The text is split into equal parts, every part but the first one starts after the end of a line
+	unsigned int threads = static_cast<unsigned int>(std::min<size_t>(m_Threads, (end - begin) / MIN_CHUNK_SIZE + 1));
+	vector<Chunk> chunks(threads);
+	for (unsigned int t = 0; t < threads; ++t)
+	{
+		const char *p = begin + (end - begin) * t / threads;
+		if (t > 0)
+		{
+			p = std::max(p, chunks[t - 1].m_Begin);
+			if (p > begin && p[-1] != '\n')
+			{
+				p = FindLineEnd(p, end);
+				p = p < end ? p + 1 : end;
+			}
+			chunks[t - 1].m_End = p;
+		}
+		chunks[t].m_Begin = p;
+		chunks[t].m_End = end;
+		chunks[t].m_MaxVertex = 0;
+		chunks[t].m_Lines = 0;
+		chunks[t].m_ErrorLine = 0;
+	}
+
+	RunThreads(threads, [&](unsigned int t)
+	{
+		ParseChunk(chunks[t]);
+	});
+
+	//  The first error of the file is the first error of the first part that has one
+	vector<size_t> offsets(threads + 1, 0);
+	size_t lines = headerLines;
+	for (unsigned int t = 0; t < threads; ++t)
+	{
+		if (!chunks[t].m_Error.empty())
+			return Fail("line " + to_string(lines + chunks[t].m_ErrorLine) + ": " + chunks[t].m_Error);
+		lines += chunks[t].m_Lines;
+		offsets[t + 1] = offsets[t] + chunks[t].m_Sources.size();
+		if (m_Format == EDGE_LIST_FORMAT && !chunks[t].m_Sources.empty())
+			m_Size = std::max(m_Size, chunks[t].m_MaxVertex + 1);
+	}
+
+	if (headerEdges != SIZE_MAX && headerEdges != offsets[threads])
+		return Fail("the problem line has " + to_string(headerEdges) + " arcs, the file has " + to_string(offsets[threads]));
+	if (offsets[threads] > UINT_MAX)
+		return Fail("the file has too many edges");
+
+	m_Sources.resize(offsets[threads]);
+	m_Targets.resize(offsets[threads]);
+	m_Weights.resize(offsets[threads]);
+	RunThreads(threads, [&](unsigned int t)
+	{
+		std::copy(chunks[t].m_Sources.begin(), chunks[t].m_Sources.end(), m_Sources.begin() + offsets[t]);
+		std::copy(chunks[t].m_Targets.begin(), chunks[t].m_Targets.end(), m_Targets.begin() + offsets[t]);
+		std::copy(chunks[t].m_Weights.begin(), chunks[t].m_Weights.end(), m_Weights.begin() + offsets[t]);
+	});
+
+	m_Seconds = duration<double>(steady_clock::now() - start).count();
+	return true;
+}
+
+bool GraphLoader::Load(const string &filename, GraphFileFormat format /* = AUTO_FORMAT */)
+{
+	steady_clock::time_point start = steady_clock::now();
+	ifstream fin(filename, ios_base::in | ios_base::binary);
+
+	if (!fin.good())
+		return Fail("can't open the file " + filename);
+
+	fin.seekg(0, ios_base::end);
+	size_t size = static_cast<size_t>(fin.tellg());
+	fin.seekg(0, ios_base::beg);
+
+	vector<char> text(size);
+	for (size_t read = 0; read < size; read += BLOCK_SIZE)
+		if (!fin.read(&text[read], std::min(BLOCK_SIZE, size - read)))
+			return Fail("can't read the file " + filename);
+	fin.close();
+
+	if (!Parse(text.data(), text.data() + size, format))
+		return false;
+
+	m_Seconds = duration<double>(steady_clock::now() - start).count();
+	return true;
+}
+
+double GraphLoader::GetMegabytesPerSecond() const
+{
+	if (m_Seconds <= 0.0)
+		return 0.0;
+	return m_Bytes / m_Seconds / 1e6;
+}
+
+//  The edges are added in the order of the file without looking for the same edge, as Graph(filename) has always done
+Graph GraphLoader::GetGraph() const
+{
+	return Graph(m_Size, m_Sources, m_Targets, m_Weights);
+}
+
+CompactGraph GraphLoader::GetCompactGraph() const
+{
+	return CompactGraph(m_Size, m_Sources, m_Targets, m_Weights);
+}
@@ -0,0 +1,95 @@
+///  Contains the parallel text graph loader declaration
+
+#ifndef GRAPHLOADER_H__
+#define GRAPHLOADER_H__
+
+#include "CompactGraph.h"
+
+//  Formats of the graph text files
+enum GraphFileFormat
+{
+	//  Find out the format from the first line of the file
+	AUTO_FORMAT,
+	//  The format of Graph(filename): the number of vertices, then "v1 v2 length" lines
+	HEX_FORMAT,
+	//  DIMACS shortest path format: "c" comments, the "p sp vertices arcs" line, then "a v1 v2 length" lines.
+	//  Vertices are numbered from 1
+	DIMACS_FORMAT,
+	//  "v1 v2" or "v1 v2 length" lines, the length is 1 if it is not given. Lines that start with # or % are comments.
+	//  The number of vertices is the biggest vertex number plus 1
+	EDGE_LIST_FORMAT
+};
+
+//  This class reads a graph from a text file much faster than ifstream >>.
+//  The file is read into memory in big blocks and split into parts at line ends, every part is parsed on its own thread
+//  by a scanner of numbers that doesn't use locales or streams. The edges are kept in the order of the file, so the graph
+//  is the same as Graph(filename) builds, and the adjacency is built from them in one pass.
+//  A malformed line stops the loading with an error that has the line number, the edges are not partially loaded
+class GraphLoader
+{
+private:
+	//  A part of the file parsed by a thread
+	struct Chunk
+	{
+		const char *m_Begin;
+		const char *m_End;
+		vector<unsigned int> m_Sources;
+		vector<unsigned int> m_Targets;
+		vector<double> m_Weights;
+		unsigned int m_MaxVertex;
+		size_t m_Lines;
+		//  The first error of the part and its line number in the part
+		string m_Error;
+		size_t m_ErrorLine;
+	};
+
+	unsigned int m_Threads;
+	GraphFileFormat m_Format;
+	unsigned int m_Size;
+	vector<unsigned int> m_Sources;
+	vector<unsigned int> m_Targets;
+	vector<double> m_Weights;
+	string m_Error;
+	size_t m_Bytes;
+	double m_Seconds;
+
+	//  Find out the format by the first line that is not empty
+	static GraphFileFormat DetectFormat(const char *begin, const char *end);
+	//  Parse the lines before the edges: the number of vertices or the "p" line. begin is moved to the first edge line,
+	//  lines gets the number of the header lines and edges the number of the edges the header has told, if it has
+	bool ParseHeader(const char *&begin, const char *end, size_t &lines, size_t &edges);
+	//  Parse the edge lines of the chunk
+	void ParseChunk(Chunk &chunk) const;
+	//  Parse a line of the edge into the chunk, a comment or an empty line is skipped. False if the line is malformed
+	bool ParseLine(const char *begin, const char *end, Chunk &chunk) const;
+	void Clear();
+	//  Clear the loaded graph and keep the error, always false
+	bool Fail(const string &error);
+public:
+	//  threads == 0 means one thread per hardware core
+	explicit GraphLoader(unsigned int threads = 0);
+	~GraphLoader();
+
+	//  Load the file, false if it can't be read or is malformed, GetError() tells why
+	bool Load(const string &filename, GraphFileFormat format = AUTO_FORMAT);
+	//  Load the graph from the text in memory
+	bool Parse(const char *begin, const char *end, GraphFileFormat format = AUTO_FORMAT);
+
+	//  Build the graphs of the loaded edges
+	Graph GetGraph() const;
+	CompactGraph GetCompactGraph() const;
+
+	unsigned int GetThreads() const { return m_Threads; }
+	void SetThreads(unsigned int threads);
+	//  The format of the last loaded file, AUTO_FORMAT if it was not loaded
+	GraphFileFormat GetFormat() const { return m_Format; }
+	unsigned int GetVerticesAmount() const { return m_Size; }
+	size_t GetEdgesAmount() const { return m_Sources.size(); }
+	const string &GetError() const { return m_Error; }
+	//  Size of the last loaded text, the time of its reading and parsing and the speed of the loading
+	size_t GetBytes() const { return m_Bytes; }
+	double GetSeconds() const { return m_Seconds; }
+	double GetMegabytesPerSecond() const;
+};
+
+#endif
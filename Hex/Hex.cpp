@@ -13,6 +13,10 @@ PlayerColor IPlayer::GetColor() const
 	return m_PlayerColor;
 }
 
+void IPlayer::SetSeed(unsigned int /* seed */)
+{
+}
+
 HumanPlayer::HumanPlayer(PlayerColor playerColor) : IPlayer(playerColor)
 {
 }
@@ -65,7 +69,7 @@ bool HumanPlayer::TryTurn(Hex& hexBoard)
 	return true;
 }
 
-RandomStrategyPlayer::RandomStrategyPlayer(PlayerColor playerColor) : IPlayer(playerColor)
+RandomStrategyPlayer::RandomStrategyPlayer(PlayerColor playerColor) : IPlayer(playerColor), m_Random(DEFAULT_SEED)
 {
 }
 
@@ -73,12 +77,17 @@ RandomStrategyPlayer::~RandomStrategyPlayer()
 {
 }
 
+void RandomStrategyPlayer::SetSeed(unsigned int seed)
+{
+	m_Random.seed(seed);
+}
+
 bool RandomStrategyPlayer::TryTurn(Hex &hexBoard)
 {
 	coordinates coord;
 
-	coord.first = rand() % hexBoard.m_Size;
-	coord.second = rand() % hexBoard.m_Size;
+	coord.first = m_Random() % hexBoard.m_Size;
+	coord.second = m_Random() % hexBoard.m_Size;
 	if (hexBoard.GetVertexColor(coord) != NONE)
 		return false;
 
@@ -88,7 +97,9 @@ bool RandomStrategyPlayer::TryTurn(Hex &hexBoard)
 	return true;
 }
 
-IPredictingPlayer::IPredictingPlayer(PlayerColor playerColor) : IPlayer(playerColor)
+IPredictingPlayer::IPredictingPlayer(PlayerColor playerColor, unsigned int timeBudget /* = 0 */) : IPlayer(playerColor),
+	m_TimeBudget(timeBudget), m_CompletedDepth(0), m_ClockCounter(0),
+	m_ClockCheckNodes(CLOCK_CHECK_NODES), m_bTimeout(false)
 {
 }
 
@@ -109,35 +120,101 @@ PlayerColor IPredictingPlayer::InverseColor()
 int IPredictingPlayer::Evaluate(Hex &hexBoard)
 {
 	if (hexBoard.GetWinner() == m_PlayerColor)
-		return 5;
+		return WIN_VALUE;
 	else if (hexBoard.GetWinner() == InverseColor())
-		return -5;
+		return -WIN_VALUE;
 	else
-		return 0;
+		return m_Evaluator.Evaluate(hexBoard, m_PlayerColor);
 }
 
-void IPredictingPlayer::GetPossibleFields(const Hex &hexBoard, vector<Hex> &boards, vector<coordinates> &coords)
+void IPredictingPlayer::StartSearch(const Hex &hexBoard)
 {
-	coordinates coord;
+	m_Deadline = steady_clock::now() + milliseconds(m_TimeBudget);
+	m_CompletedDepth = 0;
+	m_ClockCounter = 0;
+	m_bTimeout = false;
+
+	m_Fields.resize(hexBoard.m_Empty + 1);
+	for (auto it = m_Fields.begin(); it != m_Fields.end(); ++it)
+		it->reserve(hexBoard.m_Empty);
+}
 
-	for (coord.first = 0; coord.first < hexBoard.m_Size; ++coord.first)
-		for (coord.second = 0; coord.second < hexBoard.m_Size; ++coord.second)
-		{
-			Hex hexBoardCopy = hexBoard;
+bool IPredictingPlayer::IsTimeout()
+{
+	if (!m_bTimeout && m_TimeBudget != 0 && m_CompletedDepth != 0 && ++m_ClockCounter % m_ClockCheckNodes == 0)
+		m_bTimeout = steady_clock::now() >= m_Deadline;
+	return m_bTimeout;
+}
 
-			if (hexBoardCopy.GetVertexColor(coord) == NONE)
-			{
-				hexBoardCopy.SetVertexColor(coord, hexBoard.GetNextPlayerColor());
-				hexBoardCopy.SetEdgesColors(coord);
-				hexBoardCopy.m_NextPlayer = !hexBoardCopy.m_NextPlayer;
+vector<unsigned short> &IPredictingPlayer::GetEmptyFields(const Hex &hexBoard, unsigned int level, unsigned short firstMove)
+{
+	vector<unsigned short> &fields = m_Fields[level];
 
-				boards.push_back(move(hexBoardCopy));
-				coords.push_back(coord);
-			}
-		}
+	fields.clear();
+	if (firstMove != TranspositionEntry::NO_MOVE &&
+		hexBoard.GetVertexColor(coordinates(firstMove / hexBoard.m_Size, firstMove % hexBoard.m_Size)) == NONE)
+		fields.push_back(firstMove);
+	for (coordinates next(0, 0); GetNextEmptyField(hexBoard, next); ++next.second)
+	{
+		unsigned short field = next.first * hexBoard.m_Size + next.second;
+		if (field != firstMove)
+			fields.push_back(field);
+	}
+
+	return fields;
+}
+
+bool IPredictingPlayer::GetNextEmptyField(const Hex &hexBoard, coordinates &coord) const
+{
+	for (; coord.first < hexBoard.m_Size; ++coord.first, coord.second = 0)
+		for (; coord.second < hexBoard.m_Size; ++coord.second)
+			if (hexBoard.GetVertexColor(coord) == NONE)
+				return true;
+	return false;
+}
+
+bool IPredictingPlayer::ProbeTable(TranspositionTable &table, const Hex &hexBoard, unsigned int depth, int alpha, int beta, turn &res,
+	unsigned short &move) const
+{
+	TranspositionEntry entry;
+
+	move = TranspositionEntry::NO_MOVE;
+	if (!table.Probe(hexBoard.GetHash(), entry))
+		return false;
+
+	//  A result of a shallower search can't replace a deeper one, but its best move is still the best guess
+	move = entry.m_Move;
+	if (entry.m_Depth < depth)
+		return false;
+
+	if (entry.m_Bound == EXACT_BOUND || (entry.m_Bound == LOWER_BOUND && entry.m_Value >= beta) ||
+		(entry.m_Bound == UPPER_BOUND && entry.m_Value <= alpha))
+	{
+		if (entry.m_Move != TranspositionEntry::NO_MOVE)
+			res.first = coordinates(entry.m_Move / hexBoard.m_Size, entry.m_Move % hexBoard.m_Size);
+		res.second = entry.m_Value;
+		return true;
+	}
+
+	return false;
 }
 
-MinMaxPlayer::MinMaxPlayer(PlayerColor playerColor) : IPredictingPlayer(playerColor)
+void IPredictingPlayer::StoreTable(TranspositionTable &table, const Hex &hexBoard, unsigned int depth, int alpha, int beta, int value,
+	unsigned short move) const
+{
+	BoundType bound = EXACT_BOUND;
+
+	//  Search doesn't know the exact value if it is outside the window
+	if (value <= alpha)
+		bound = UPPER_BOUND;
+	else if (value >= beta)
+		bound = LOWER_BOUND;
+
+	table.Store(hexBoard.GetHash(), value, bound, depth, move);
+}
+
+MinMaxPlayer::MinMaxPlayer(PlayerColor playerColor, unsigned int timeBudget /* = 1000 */) : IPredictingPlayer(playerColor, timeBudget),
+	m_RootMove(TranspositionEntry::NO_MOVE), m_RootLevel(0)
 {
 }
 
@@ -150,26 +227,29 @@ turn MinMaxPlayer::Min(Hex &hexBoard, const coordinates& coord, unsigned int lev
 	//  The minimum initial value for level is 1 (because if the board is full there is no intenion to try to make a move)
 	turn res, t;
 
+	res.first = coord;
+	if (IsTimeout())
+		return res;
+
 	if (level == 0 || hexBoard.GetWinner() != NONE)
-	{
-		res.first = coord;
 		res.second = Evaluate(hexBoard);
-	}
 	else
 	{
-		vector<Hex> boards;
-		vector<coordinates> coords;
+		const vector<unsigned short> &fields = GetEmptyFields(hexBoard, level, TranspositionEntry::NO_MOVE);
 
-		GetPossibleFields(hexBoard, boards, coords);
-		res.first = coord;
 		res.second = INT_MAX;
-		auto coordsIt = coords.begin();
-		for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+		for (size_t i = 0; i < fields.size(); ++i)
 		{
-			t = Max(*boardsIt, *coordsIt, level - 1);
+			coordinates next(fields[i] / hexBoard.m_Size, fields[i] % hexBoard.m_Size);
+
+			hexBoard.MakeMove(next);
+			t = Max(hexBoard, next, level - 1);
+			hexBoard.UndoMove();
+			if (m_bTimeout)
+				break;
 			if (t.second < res.second)
 			{
-				res.first = *coordsIt;
+				res.first = next;
 				res.second = t.second;
 			}
 		}
@@ -183,26 +263,31 @@ turn MinMaxPlayer::Max(Hex &hexBoard, const coordinates& coord, unsigned int lev
 	//  The minimum initial value for level is 1 (because if the board is full there is no intenion to try to make a move)
 	turn res, t;
 
+	res.first = coord;
+	if (IsTimeout())
+		return res;
+
 	if (level == 0 || hexBoard.GetWinner() != NONE)
-	{
-		res.first = coord;
 		res.second = Evaluate(hexBoard);
-	}
-	else 
+	else
 	{
-		vector<Hex> boards;
-		vector<coordinates> coords;
+		//  Without a table only the root knows the best move of the previous iteration
+		const vector<unsigned short> &fields = GetEmptyFields(hexBoard, level,
+			level == m_RootLevel ? m_RootMove : TranspositionEntry::NO_MOVE);
 
-		GetPossibleFields(hexBoard, boards, coords);
-		res.first = coord;
 		res.second = INT_MIN;
-		auto coordsIt = coords.begin();
-		for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+		for (size_t i = 0; i < fields.size(); ++i)
 		{
-			t = Min(*boardsIt, *coordsIt, level - 1);
+			coordinates next(fields[i] / hexBoard.m_Size, fields[i] % hexBoard.m_Size);
+
+			hexBoard.MakeMove(next);
+			t = Min(hexBoard, next, level - 1);
+			hexBoard.UndoMove();
+			if (m_bTimeout)
+				break;
 			if (t.second > res.second)
 			{
-				res.first = *coordsIt;
+				res.first = next;
 				res.second = t.second;
 			}
 		}
@@ -212,14 +297,32 @@ turn MinMaxPlayer::Max(Hex &hexBoard, const coordinates& coord, unsigned int lev
 
 bool MinMaxPlayer::TryTurn(Hex& hexBoard)
 {
-	turn madeTurn = Max(hexBoard, coordinates(0, 0), hexBoard.m_Empty);
+	turn madeTurn, t;
+
+	StartSearch(hexBoard);
+	m_RootMove = TranspositionEntry::NO_MOVE;
+	for (m_RootLevel = 1; m_RootLevel <= hexBoard.m_Empty; ++m_RootLevel)
+	{
+		t = Max(hexBoard, coordinates(0, 0), m_RootLevel);
+		if (m_bTimeout)
+			break;
+
+		madeTurn = t;
+		m_RootMove = madeTurn.first.first * hexBoard.m_Size + madeTurn.first.second;
+		m_CompletedDepth = m_RootLevel;
+		//  The game is decided within the searched depth, a deeper search gives the same result
+		if (madeTurn.second >= WIN_VALUE || madeTurn.second <= -WIN_VALUE)
+			break;
+	}
 
 	hexBoard.SetVertexColor(madeTurn.first, m_PlayerColor);
 	hexBoard.SetEdgesColors(madeTurn.first);
 	return true;
 }
 
-AlphaBetaPlayer::AlphaBetaPlayer(PlayerColor playerColor) : IPredictingPlayer(playerColor)
+AlphaBetaPlayer::AlphaBetaPlayer(PlayerColor playerColor, unsigned int timeBudget /* = 1000 */, size_t tableMemory /* = 16 << 20 */) :
+	IPredictingPlayer(playerColor, timeBudget), m_Table(tableMemory), m_RootLevel(0), m_Nodes(0), m_Cutoffs(0),
+	m_FirstFieldCutoffs(0), m_ReSearches(0), m_IterationNodes(0)
 {
 }
 
@@ -227,36 +330,139 @@ AlphaBetaPlayer::~AlphaBetaPlayer()
 {
 }
 
+unsigned int AlphaBetaPlayer::HistoryIndex(const Hex &hexBoard, unsigned short field) const
+{
+	return (hexBoard.GetNextPlayerColor() == RED ? 0 : hexBoard.m_Size * hexBoard.m_Size) + field;
+}
+
+vector<unsigned short> &AlphaBetaPlayer::GetOrderedFields(const Hex &hexBoard, unsigned int level, unsigned short tableMove)
+{
+	vector<unsigned short> &fields = GetEmptyFields(hexBoard, level, tableMove);
+	vector<unsigned int> &scores = m_Scores[level];
+	const unsigned short *killers = &m_Killers[(m_RootLevel - level) * KILLERS_PER_PLY];
+
+	//  The table move gets the highest score, killers follow it. History scores are kept below them
+	scores.resize(fields.size());
+	for (size_t i = 0; i < fields.size(); ++i)
+	{
+		if (fields[i] == tableMove)
+			scores[i] = UINT_MAX;
+		else if (fields[i] == killers[0])
+			scores[i] = UINT_MAX - 1;
+		else if (fields[i] == killers[1])
+			scores[i] = UINT_MAX - 2;
+		else
+			scores[i] = m_History[HistoryIndex(hexBoard, fields[i])];
+	}
+
+	return fields;
+}
+
+void AlphaBetaPlayer::StartOrdering(const Hex &hexBoard)
+{
+	m_Scores.resize(m_Fields.size());
+	for (auto it = m_Scores.begin(); it != m_Scores.end(); ++it)
+		it->reserve(hexBoard.m_Empty);
+	m_Killers.assign(m_Fields.size() * KILLERS_PER_PLY, static_cast<unsigned short>(TranspositionEntry::NO_MOVE));
+
+	//  History of the previous moves is still useful but counts less
+	m_History.resize(2 * hexBoard.m_Size * hexBoard.m_Size);
+	for (auto it = m_History.begin(); it != m_History.end(); ++it)
+		*it /= 2;
+}
+
+void AlphaBetaPlayer::PickNextField(unsigned int level, size_t i)
+{
+	vector<unsigned short> &fields = m_Fields[level];
+	vector<unsigned int> &scores = m_Scores[level];
+	size_t best = i;
+
+	//  Selection is lazy because after a cutoff the rest of the fields is not needed
+	for (size_t j = i + 1; j < fields.size(); ++j)
+		if (scores[j] > scores[best])
+			best = j;
+
+	std::swap(fields[i], fields[best]);
+	std::swap(scores[i], scores[best]);
+}
+
+void AlphaBetaPlayer::StoreCutoff(const Hex &hexBoard, unsigned int level, unsigned short field)
+{
+	unsigned short *killers = &m_Killers[(m_RootLevel - level) * KILLERS_PER_PLY];
+	unsigned int &history = m_History[HistoryIndex(hexBoard, field)];
+
+	if (killers[0] != field)
+	{
+		killers[1] = killers[0];
+		killers[0] = field;
+	}
+
+	//  Keep history scores far below the scores of the table and killer moves
+	history += level * level;
+	if (history > (1u << 30))
+		for (auto it = m_History.begin(); it != m_History.end(); ++it)
+			*it /= 2;
+}
+
 turn AlphaBetaPlayer::Min(Hex &hexBoard, const coordinates& coord, int alpha, int beta, unsigned int level)
 {
 	//  The minimum initial value for level is 1 (because if the board is full there is no intenion to try to make a move)
 	turn res, t;
 
+	m_Nodes++;
+	res.first = coord;
+	if (IsTimeout())
+		return res;
+
 	if (level == 0 || hexBoard.GetWinner() != NONE)
-	{
-		res.first = coord;
 		res.second = Evaluate(hexBoard);
-	}
 	else
 	{
-		vector<Hex> boards;
-		vector<coordinates> coords;
+		unsigned short bestMove = TranspositionEntry::NO_MOVE, tableMove;
+
+		if (ProbeTable(m_Table, hexBoard, level, alpha, beta, res, tableMove))
+			return res;
+
+		vector<unsigned short> &fields = GetOrderedFields(hexBoard, level, tableMove);
 
-		GetPossibleFields(hexBoard, boards, coords);
-		res.first = coord;
 		res.second = beta;
-		auto coordsIt = coords.begin();
-		for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+		for (size_t i = 0; i < fields.size(); ++i)
 		{
-			t = Max(*boardsIt, *coordsIt, alpha, res.second, level - 1);
+			PickNextField(level, i);
+			coordinates next(fields[i] / hexBoard.m_Size, fields[i] % hexBoard.m_Size);
+
+			hexBoard.MakeMove(next);
+			if (i == 0)
+				t = Max(hexBoard, next, alpha, res.second, level - 1);
+			else
+			{
+				t = Max(hexBoard, next, res.second - 1, res.second, level - 1);
+				if (!m_bTimeout && t.second < res.second && t.second > alpha)
+				{
+					m_ReSearches++;
+					t = Max(hexBoard, next, alpha, res.second, level - 1);
+				}
+			}
+			hexBoard.UndoMove();
+			if (m_bTimeout)
+				return res;
 			if (t.second < res.second)
 			{
-				res.first = *coordsIt;
+				res.first = next;
 				res.second = t.second;
+				bestMove = fields[i];
 			}
 			if (res.second <= alpha)
-				return res;
+			{
+				m_Cutoffs++;
+				if (i == 0)
+					m_FirstFieldCutoffs++;
+				StoreCutoff(hexBoard, level, fields[i]);
+				break;
+			}
 		}
+
+		StoreTable(m_Table, hexBoard, level, alpha, beta, res.second, bestMove);
 	}
 
 	return res;
@@ -267,66 +473,130 @@ turn AlphaBetaPlayer::Max(Hex &hexBoard, const coordinates& coord, int alpha, in
 	//  The minimum initial value for level is 1 (because if the board is full there is no intenion to try to make a move)
 	turn res, t;
 
+	m_Nodes++;
+	res.first = coord;
+	if (IsTimeout())
+		return res;
+
 	if (level == 0 || hexBoard.GetWinner() != NONE)
-	{
-		res.first = coord;
 		res.second = Evaluate(hexBoard);
-	}
-	else 
+	else
 	{
-		vector<Hex> boards;
-		vector<coordinates> coords;
+		unsigned short bestMove = TranspositionEntry::NO_MOVE, tableMove;
+
+		if (ProbeTable(m_Table, hexBoard, level, alpha, beta, res, tableMove))
+			return res;
+
+		vector<unsigned short> &fields = GetOrderedFields(hexBoard, level, tableMove);
 
-		GetPossibleFields(hexBoard, boards, coords);
-		res.first = coord;
 		res.second = alpha;
-		auto coordsIt = coords.begin();
-		for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+		for (size_t i = 0; i < fields.size(); ++i)
 		{
-			t = Min(*boardsIt, *coordsIt, res.second, beta, level - 1);
+			PickNextField(level, i);
+			coordinates next(fields[i] / hexBoard.m_Size, fields[i] % hexBoard.m_Size);
+
+			hexBoard.MakeMove(next);
+			if (i == 0)
+				t = Min(hexBoard, next, res.second, beta, level - 1);
+			else
+			{
+				t = Min(hexBoard, next, res.second, res.second + 1, level - 1);
+				if (!m_bTimeout && t.second > res.second && t.second < beta)
+				{
+					m_ReSearches++;
+					t = Min(hexBoard, next, res.second, beta, level - 1);
+				}
+			}
+			hexBoard.UndoMove();
+			if (m_bTimeout)
+				return res;
 			if (t.second > res.second)
 			{
-				res.first = *coordsIt;
+				res.first = next;
 				res.second = t.second;
+				bestMove = fields[i];
 			}
 			if (res.second >= beta)
-				return res;
+			{
+				m_Cutoffs++;
+				if (i == 0)
+					m_FirstFieldCutoffs++;
+				StoreCutoff(hexBoard, level, fields[i]);
+				break;
+			}
 		}
+
+		StoreTable(m_Table, hexBoard, level, alpha, beta, res.second, bestMove);
 	}
+
 	return res;
 }
 
 bool AlphaBetaPlayer::TryTurn(Hex& hexBoard)
 {
-	turn madeTurn = Max(hexBoard, coordinates(0, 0), INT_MIN, INT_MAX, hexBoard.m_Empty);
+	turn madeTurn, t;
+
+	StartSearch(hexBoard);
+	StartOrdering(hexBoard);
+	for (m_RootLevel = 1; m_RootLevel <= hexBoard.m_Empty; ++m_RootLevel)
+	{
+		unsigned long long nodes = m_Nodes;
+
+		t = Max(hexBoard, coordinates(0, 0), INT_MIN, INT_MAX, m_RootLevel);
+		if (m_bTimeout)
+			break;
+
+		madeTurn = t;
+		m_CompletedDepth = m_RootLevel;
+		m_IterationNodes = m_Nodes - nodes;
+		//  The game is decided within the searched depth, a deeper search gives the same result
+		if (madeTurn.second >= WIN_VALUE || madeTurn.second <= -WIN_VALUE)
+			break;
+	}
 
 	hexBoard.SetVertexColor(madeTurn.first, m_PlayerColor);
 	hexBoard.SetEdgesColors(madeTurn.first);
 	return true;
 }
 
-MonteCarloAlphaBetaPlayer::MonteCarloAlphaBetaPlayer(PlayerColor playerColor) : IPredictingPlayer(playerColor), m_InitialLevel(0), m_Simulations(500)
+double AlphaBetaPlayer::GetEffectiveBranchingFactor() const
+{
+	if (m_CompletedDepth == 0)
+		return 0;
+	return pow(static_cast<double>(m_IterationNodes), 1.0 / m_CompletedDepth);
+}
+
+void AlphaBetaPlayer::ResetStatistics()
+{
+	m_Nodes = 0;
+	m_Cutoffs = 0;
+	m_FirstFieldCutoffs = 0;
+	m_ReSearches = 0;
+}
+
+MonteCarloAlphaBetaPlayer::MonteCarloAlphaBetaPlayer(PlayerColor playerColor, unsigned int timeBudget /* = 0 */,
+	size_t tableMemory /* = 16 << 20 */) : IPredictingPlayer(playerColor, timeBudget), m_InitialLevel(0), m_Depth(MAX_DEPTH),
+	m_Simulations(500), m_Playout(DEFAULT_SEED), m_Table(tableMemory)
 {
+	//  A leaf runs m_Simulations playouts, that is longer than a clock read, so the clock is read at every position
+	m_ClockCheckNodes = 1;
 }
 
 MonteCarloAlphaBetaPlayer::~MonteCarloAlphaBetaPlayer()
 {
 }
 
-int MonteCarloAlphaBetaPlayer::Evaluate(Hex &hexBoard)
+void MonteCarloAlphaBetaPlayer::SetSeed(unsigned int seed)
 {
-	int eval_val = 0;
+	m_Playout.SetSeed(seed);
+}
 
-	for (int i = 0; i < m_Simulations; ++i)
-	{
-		Hex hexCopy = hexBoard;
-		PlayerColor winner = hexCopy.RandomSimulation();
-		if (winner == m_PlayerColor)
-			eval_val++;
-		else
-			eval_val--;
-	}
-	return eval_val;
+int MonteCarloAlphaBetaPlayer::Evaluate(Hex &hexBoard)
+{
+	//  +1 for each won simulation and -1 for each lost one
+	m_Playout.Load(hexBoard);
+	int wins = m_Playout.Run(m_Simulations, m_PlayerColor);
+	return 2 * wins - static_cast<int>(m_Simulations);
 }
 
 turn MonteCarloAlphaBetaPlayer::Min(Hex &hexBoard, const coordinates& coord, int alpha, int beta, unsigned int level)
@@ -334,31 +604,41 @@ turn MonteCarloAlphaBetaPlayer::Min(Hex &hexBoard, const coordinates& coord, int
 	//  The minimum initial value for level is 1 (because if the board is full there is no intenion to try to make a move)
 	turn res, t;
 
-	if (level == 0 || level <= m_InitialLevel - 2 || hexBoard.GetWinner() != NONE)
-	{
-		res.first = coord;
+	res.first = coord;
+	if (IsTimeout())
+		return res;
+
+	if (level == 0 || level <= m_InitialLevel - m_Depth || hexBoard.GetWinner() != NONE)
 		res.second = Evaluate(hexBoard);
-	}
 	else
 	{
-		vector<Hex> boards;
-		vector<coordinates> coords;
+		coordinates next(0, 0);
+		unsigned short bestMove = TranspositionEntry::NO_MOVE, tableMove;
+
+		if (ProbeTable(m_Table, hexBoard, level + m_Depth - m_InitialLevel, alpha, beta, res, tableMove))
+			return res;
 
-		GetPossibleFields(hexBoard, boards, coords);
-		res.first = coord;
 		res.second = beta;
-		auto coordsIt = coords.begin();
-		for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+		for (; GetNextEmptyField(hexBoard, next); ++next.second)
 		{
-			t = Max(*boardsIt, *coordsIt, alpha, res.second, level - 1);
+			hexBoard.MakeMove(next);
+			t = Max(hexBoard, next, alpha, res.second, level - 1);
+			hexBoard.UndoMove();
+			if (m_bTimeout)
+				break;
 			if (t.second < res.second)
 			{
-				res.first = *coordsIt;
+				res.first = next;
 				res.second = t.second;
+				bestMove = next.first * hexBoard.m_Size + next.second;
 			}
 			if (res.second <= alpha)
-				return res;
+				break;
 		}
+
+		//  The result of an interrupted search is not valid
+		if (!m_bTimeout)
+			StoreTable(m_Table, hexBoard, level + m_Depth - m_InitialLevel, alpha, beta, res.second, bestMove);
 	}
 
 	return res;
@@ -369,101 +649,388 @@ turn MonteCarloAlphaBetaPlayer::Max(Hex &hexBoard, const coordinates& coord, int
 	//  The minimum initial value for level is 1 (because if the board is full there is no intenion to try to make a move)
 	turn res, t;
 
-	if (level == 0 || level <= m_InitialLevel - 2 || hexBoard.GetWinner() != NONE)
-	{
-		res.first = coord;
+	res.first = coord;
+	if (IsTimeout())
+		return res;
+
+	if (level == 0 || level <= m_InitialLevel - m_Depth || hexBoard.GetWinner() != NONE)
 		res.second = Evaluate(hexBoard);
-	}
-	else 
+	else
 	{
-		vector<Hex> boards;
-		vector<coordinates> coords;
+		coordinates next(0, 0);
+		unsigned short bestMove = TranspositionEntry::NO_MOVE, tableMove;
+
+		if (ProbeTable(m_Table, hexBoard, level + m_Depth - m_InitialLevel, alpha, beta, res, tableMove))
+			return res;
 
-		GetPossibleFields(hexBoard, boards, coords);
-		res.first = coord;
 		res.second = alpha;
-		auto coordsIt = coords.begin();
-		for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+		for (; GetNextEmptyField(hexBoard, next); ++next.second)
 		{
-			t = Min(*boardsIt, *coordsIt, res.second, beta, level - 1);
+			hexBoard.MakeMove(next);
+			t = Min(hexBoard, next, res.second, beta, level - 1);
+			hexBoard.UndoMove();
+			if (m_bTimeout)
+				break;
 			if (t.second > res.second)
 			{
-				res.first = *coordsIt;
+				res.first = next;
 				res.second = t.second;
+				bestMove = next.first * hexBoard.m_Size + next.second;
 			}
 			if (res.second >= beta)
-				return res;
+				break;
 		}
+
+		//  The result of an interrupted search is not valid
+		if (!m_bTimeout)
+			StoreTable(m_Table, hexBoard, level + m_Depth - m_InitialLevel, alpha, beta, res.second, bestMove);
 	}
+
 	return res;
 }
 
 bool MonteCarloAlphaBetaPlayer::TryTurn(Hex& hexBoard)
 {
+	turn madeTurn, t;
+
+	StartSearch(hexBoard);
 	m_InitialLevel = hexBoard.m_Empty;
-	turn madeTurn = Max(hexBoard, coordinates(0, 0), INT_MIN, INT_MAX, hexBoard.m_Empty);
+	for (m_Depth = 1; m_Depth <= MAX_DEPTH; ++m_Depth)
+	{
+		t = Max(hexBoard, coordinates(0, 0), INT_MIN, INT_MAX, hexBoard.m_Empty);
+		if (m_bTimeout)
+			break;
+
+		madeTurn = t;
+		m_CompletedDepth = m_Depth;
+	}
 
 	hexBoard.SetVertexColor(madeTurn.first, m_PlayerColor);
 	hexBoard.SetEdgesColors(madeTurn.first);
 	return true;
 }
 
-MonteCarloPlayer::MonteCarloPlayer(PlayerColor playerColor) : IPredictingPlayer(playerColor), m_Simulations(500)
+MonteCarloPlayer::MonteCarloPlayer(PlayerColor playerColor, unsigned int threads /* = 0 */) : IPredictingPlayer(playerColor),
+	m_Simulations(500), m_Threads(threads), m_Playout(DEFAULT_SEED), m_Random(DEFAULT_SEED)
 {
+	if (m_Threads == 0)
+		m_Threads = thread::hardware_concurrency();
+	if (m_Threads == 0)  //  hardware_concurrency may be unknown
+		m_Threads = 1;
 }
 
 MonteCarloPlayer::~MonteCarloPlayer()
 {
 }
 
+void MonteCarloPlayer::SetSeed(unsigned int seed)
+{
+	m_Random.seed(seed);
+	m_Playout.SetSeed(m_Random());
+}
+
 int MonteCarloPlayer::Evaluate(Hex &hexBoard)
 {
-	int eval_val = 0;
+	//  +1 for each won simulation and -1 for each lost one
+	m_Playout.Load(hexBoard);
+	int wins = m_Playout.Run(m_Simulations, m_PlayerColor);
+	return 2 * wins - static_cast<int>(m_Simulations);
+}
+
+void MonteCarloPlayer::EvaluateFields(const Hex &hexBoard, const vector<unsigned int> &fields, unsigned int simulations, unsigned int seed,
+	vector<unsigned int> &wins) const
+{
+	HexPlayout playout(seed);
 
-	for (int i = 0; i < m_Simulations; ++i)
+	for (size_t i = 0; i < fields.size(); ++i)
 	{
-		Hex hexCopy = hexBoard;
-		PlayerColor winner = hexCopy.RandomSimulation();
-		if (winner == m_PlayerColor)
-			eval_val++;
-		else
-			eval_val--;
+		playout.Load(hexBoard);
+		playout.Place(fields[i], m_PlayerColor);
+		wins[i] = playout.Run(simulations, m_PlayerColor);
 	}
-	return eval_val;
 }
 
 bool MonteCarloPlayer::TryTurn(Hex& hexBoard)
 {
-	vector<Hex> boards;
-	vector<coordinates> coords;
-	turn madeTurn = turn(coordinates(0, 0), INT_MIN);
-	int val;
+	vector<unsigned int> fields;
+	coordinates coord;
+
+	for (coord.first = 0; coord.first < hexBoard.m_Size; ++coord.first)
+		for (coord.second = 0; coord.second < hexBoard.m_Size; ++coord.second)
+			if (hexBoard.GetVertexColor(coord) == NONE)
+				fields.push_back(coord.first * hexBoard.m_Size + coord.second);
 
-	GetPossibleFields(hexBoard, boards, coords);
-	auto coordsIt = coords.begin();
-	for (auto boardsIt = boards.begin(); boardsIt != boards.end(); ++boardsIt, ++coordsIt)
+	if (fields.empty())
+		return false;
+
+	//  Each thread gets its share of the simulations of every field and its own row of wins
+	unsigned int threads = std::min(m_Threads, m_Simulations);
+	vector<vector<unsigned int>> wins(threads, vector<unsigned int>(fields.size(), 0));
+	vector<thread> workers;
+
+	for (unsigned int t = 1; t < threads; ++t)
 	{
-		val = Evaluate(*boardsIt);
-		if (val > madeTurn.second)
+		unsigned int simulations = m_Simulations / threads + (t < m_Simulations % threads ? 1 : 0);
+		workers.push_back(thread(&MonteCarloPlayer::EvaluateFields, this, std::cref(hexBoard), std::cref(fields), simulations,
+			static_cast<unsigned int>(m_Random()), std::ref(wins[t])));
+	}
+	//  The current thread is the worker 0
+	EvaluateFields(hexBoard, fields, m_Simulations / threads + (0 < m_Simulations % threads ? 1 : 0), m_Random(), wins[0]);
+
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		it->join();
+
+	//  Merge the votes. The field with the most wins is the best one
+	unsigned int best = 0, bestWins = 0;
+	for (size_t i = 0; i < fields.size(); ++i)
+	{
+		unsigned int fieldWins = 0;
+		for (unsigned int t = 0; t < threads; ++t)
+			fieldWins += wins[t][i];
+		if (i == 0 || fieldWins > bestWins)
 		{
-			madeTurn.first = *coordsIt;
-			madeTurn.second = val;
+			best = fields[i];
+			bestWins = fieldWins;
 		}
 	}
 
-	hexBoard.SetVertexColor(madeTurn.first, m_PlayerColor);
-	hexBoard.SetEdgesColors(madeTurn.first);
+	coord = coordinates(best / hexBoard.m_Size, best % hexBoard.m_Size);
+	hexBoard.SetVertexColor(coord, m_PlayerColor);
+	hexBoard.SetEdgesColors(coord);
 	return true;
 }
 
-Hex::Hex(unsigned int size) : m_Size(size), m_Empty(m_Size*m_Size), m_HexBoard(size*size + 4),
-	m_Left(size*size), m_Right(size*size + 1), m_Top(size*size + 2), m_Bottom(size*size + 3)
+MonteCarloTreeSearchPlayer::MonteCarloTreeSearchPlayer(PlayerColor playerColor, unsigned int timeBudget /* = 1000 */,
+	unsigned int maxNodes /* = 1 << 20 */) : IPredictingPlayer(playerColor, timeBudget), m_MaxNodes(maxNodes),
+	m_Exploration(0.1), m_RaveEquivalence(1000.0), m_NodesUsed(0), m_Iterations(0), m_RootPlayout(DEFAULT_SEED), m_Playout(DEFAULT_SEED + 1)
+{
+	//  The whole pool is allocated once, nodes are never allocated one by one
+	m_Pool.resize(m_MaxNodes);
+}
+
+MonteCarloTreeSearchPlayer::~MonteCarloTreeSearchPlayer()
 {
-	srand(time(NULL));
+}
+
+void MonteCarloTreeSearchPlayer::SetSeed(unsigned int seed)
+{
+	std::mt19937 random(seed);
+	m_RootPlayout.SetSeed(random());
+	m_Playout.SetSeed(random());
+}
+
+unsigned int MonteCarloTreeSearchPlayer::SelectChild(unsigned int node) const
+{
+	const MctsNode &parent = m_Pool[node];
+	double logVisits = log(static_cast<double>(parent.m_Visits + 1));
+	unsigned int best = parent.m_FirstChild;
+	double bestValue = -1.0;
+
+	for (unsigned int i = parent.m_FirstChild; i < parent.m_FirstChild + parent.m_ChildrenAmount; ++i)
+	{
+		const MctsNode &child = m_Pool[i];
+		//  Children without any statistics are optimistically considered as winning
+		double winRate = child.m_Visits ? static_cast<double>(child.m_Wins) / child.m_Visits : 1.0;
+		double amafRate = child.m_AmafVisits ? static_cast<double>(child.m_AmafWins) / child.m_AmafVisits : 1.0;
+		//  The weight of RAVE goes from 1 to 0 as the child gets real visits
+		double beta = sqrt(m_RaveEquivalence / (3 * child.m_Visits + m_RaveEquivalence));
+		double value = (1 - beta) * winRate + beta * amafRate + m_Exploration * sqrt(logVisits / (child.m_Visits + 1));
+
+		if (value > bestValue)
+		{
+			best = i;
+			bestValue = value;
+		}
+	}
+
+	return best;
+}
+
+void MonteCarloTreeSearchPlayer::Backpropagate(unsigned int node, PlayerColor winner)
+{
+	const vector<PlayerColor> &board = m_Playout.GetBoard();
+
+	while (true)
+	{
+		MctsNode &current = m_Pool[node];
+		current.m_Visits++;
+		if (current.m_Color == winner)
+			current.m_Wins++;
+
+		//  Every child whose cell was taken by the child's color in this game gets the result too
+		for (unsigned int i = current.m_FirstChild; i < current.m_FirstChild + current.m_ChildrenAmount; ++i)
+		{
+			MctsNode &child = m_Pool[i];
+			if (board[child.m_Cell] == child.m_Color)
+			{
+				child.m_AmafVisits++;
+				if (child.m_Color == winner)
+					child.m_AmafWins++;
+			}
+		}
+
+		if (node == 0)
+			break;
+		node = current.m_Parent;
+	}
+}
+
+bool MonteCarloTreeSearchPlayer::Expand(unsigned int node)
+{
+	const vector<unsigned int> &cells = m_Playout.GetEmptyCells();
+	if (m_NodesUsed + cells.size() > m_MaxNodes)
+		return false;
+
+	MctsNode &parent = m_Pool[node];
+	parent.m_FirstChild = m_NodesUsed;
+	parent.m_ChildrenAmount = cells.size();
+	for (auto it = cells.begin(); it != cells.end(); ++it)
+	{
+		MctsNode &child = m_Pool[m_NodesUsed++];
+		child.m_Parent = node;
+		child.m_FirstChild = 0;
+		child.m_ChildrenAmount = 0;
+		child.m_Visits = 0;
+		child.m_Wins = 0;
+		child.m_AmafVisits = 0;
+		child.m_AmafWins = 0;
+		child.m_Cell = *it;
+		child.m_Color = m_Playout.GetNextColor();
+	}
+
+	return true;
+}
+
+void MonteCarloTreeSearchPlayer::Iterate()
+{
+	unsigned int node = 0;
+
+	m_Playout.LoadPosition(m_RootPlayout);
+
+	//  Selection
+	while (m_Pool[node].m_ChildrenAmount > 0)
+	{
+		node = SelectChild(node);
+		m_Playout.Place(m_Pool[node].m_Cell, m_Pool[node].m_Color);
+	}
+
+	//  Expansion of a leaf that was already visited (the root is always expanded)
+	if ((node == 0 || m_Pool[node].m_Visits > 0) && !m_Playout.GetEmptyCells().empty() && Expand(node))
+	{
+		node = SelectChild(node);
+		m_Playout.Place(m_Pool[node].m_Cell, m_Pool[node].m_Color);
+	}
+
+	//  Simulation
+	PlayerColor winner = m_Playout.Play();
 
-	m_Player1 = new HumanPlayer(RED);
-	m_Player2 = new MonteCarloPlayer(BLUE);
+	Backpropagate(node, winner);
+}
+
+bool MonteCarloTreeSearchPlayer::TryTurn(Hex& hexBoard)
+{
+	steady_clock::time_point deadline = steady_clock::now() + milliseconds(m_TimeBudget);
+
+	m_RootPlayout.Load(hexBoard);
+	if (m_RootPlayout.GetEmptyCells().empty())
+		return false;
+
+	//  The root is the current position, the move leading to it was made by the opponent
+	MctsNode &root = m_Pool[0];
+	root.m_Parent = UINT_MAX;
+	root.m_FirstChild = 0;
+	root.m_ChildrenAmount = 0;
+	root.m_Visits = 0;
+	root.m_Wins = 0;
+	root.m_AmafVisits = 0;
+	root.m_AmafWins = 0;
+	root.m_Cell = 0;
+	root.m_Color = InverseColor();
+	m_NodesUsed = 1;
+	m_Iterations = 0;
+
+	//  The clock is checked once in a while because it is not free
+	do
+	{
+		for (unsigned int i = 0; i < 64; ++i)
+			Iterate();
+		m_Iterations += 64;
+	} while (steady_clock::now() < deadline);
+
+	//  The most visited move is the most reliable one. If the pool was too small even for the root
+	//  children then just take the first empty cell
+	unsigned int cell = m_RootPlayout.GetEmptyCells().front();
+	unsigned int bestVisits = 0;
+	for (unsigned int i = root.m_FirstChild; i < root.m_FirstChild + root.m_ChildrenAmount; ++i)
+		if (m_Pool[i].m_Visits > bestVisits)
+		{
+			cell = m_Pool[i].m_Cell;
+			bestVisits = m_Pool[i].m_Visits;
+		}
+
+	coordinates coord(cell / hexBoard.m_Size, cell % hexBoard.m_Size);
+	hexBoard.SetVertexColor(coord, m_PlayerColor);
+	hexBoard.SetEdgesColors(coord);
+	return true;
+}
+
+HexGridHeuristic::HexGridHeuristic(unsigned int size, double minWeight) : m_Size(size), m_MinWeight(minWeight)
+{
+}
+
+HexGridHeuristic::~HexGridHeuristic()
+{
+}
+
+unsigned int HexGridHeuristic::GetSideDistance(unsigned int row, unsigned int column) const
+{
+	return 1 + std::min(std::min(row, m_Size - 1 - row), std::min(column, m_Size - 1 - column));
+}
+
+double HexGridHeuristic::GetEstimate(unsigned int from, unsigned int to) const
+{
+	if (from >= m_Size * m_Size || to >= m_Size * m_Size)
+		return 0.0;
+
+	int di = static_cast<int>(to / m_Size) - static_cast<int>(from / m_Size);
+	int dj = static_cast<int>(to % m_Size) - static_cast<int>(from % m_Size);
+	unsigned int edges = (abs(di) + abs(dj) + abs(di + dj)) / 2;
+	unsigned int sideEdges = GetSideDistance(from / m_Size, from % m_Size) + GetSideDistance(to / m_Size, to % m_Size);
+
+	return std::min(edges, sideEdges) * m_MinWeight;
+}
+
+Hex::Hex(unsigned int size, HexBoardType boardType) : Hex(size, make_shared<HumanPlayer>(RED), make_shared<MonteCarloPlayer>(BLUE), boardType)
+{
+	//  main seeds rand() with the time, so the computer plays differently in every game
+	m_Player2->SetSeed(rand());
+}
+
+Hex::Hex(unsigned int size, shared_ptr<IPlayer> player1, shared_ptr<IPlayer> player2, HexBoardType boardType) : m_Left(size*size),
+	m_Right(size*size + 1), m_Top(size*size + 2), m_Bottom(size*size + 3), m_BoardType(GetSupportedBoardType(size, boardType)),
+	m_HexBoard(m_BoardType == GRAPH_BOARD ? size*size + 4 : 0), m_Groups(m_BoardType == GRAPH_BOARD ? size*size + 4 : 0),
+	m_Bitboard(m_BoardType == BIT_BOARD ? size : 0), m_Size(size), m_Empty(m_Size*m_Size), m_Hash(0)
+{
+	m_Player1 = player1;
+	m_Player2 = player2;
 	m_NextPlayer = 1;
+
+	//  The bitboard has precomputed neighbors and sides, so the Graph is needed only for the Graph board
+	if (m_BoardType == GRAPH_BOARD)
+		BuildBoardGraph();
+}
+
+HexBoardType Hex::GetSupportedBoardType(unsigned int size, HexBoardType boardType)
+{
+	if (boardType == BIT_BOARD && size > HexBitboard::MAX_SIZE)
+		return GRAPH_BOARD;
+	return boardType;
+}
+
+void Hex::BuildBoardGraph()
+{
+	unsigned int size = m_Size;
+
 	//  line 1 
 	m_HexBoard.AddEdge(0, 1);
 	m_HexBoard.AddEdge(0, size);
@@ -550,26 +1117,20 @@ Hex::Hex(unsigned int size) : m_Size(size), m_Empty(m_Size*m_Size), m_HexBoard(s
 	}
 }
 
-Hex::Hex(const Hex &hex) : m_Size(hex.m_Size), m_Empty(hex.m_Empty), m_HexBoard(hex.m_HexBoard),
-	m_Left(hex.m_Left), m_Right(hex.m_Right), m_Top(hex.m_Top), m_Bottom(hex.m_Bottom), m_NextPlayer(hex.m_NextPlayer)
+Hex::Hex(const Hex &hex) : m_Left(hex.m_Left), m_Right(hex.m_Right), m_Top(hex.m_Top), m_Bottom(hex.m_Bottom), m_BoardType(hex.m_BoardType),
+	m_HexBoard(hex.m_HexBoard), m_Groups(hex.m_Groups), m_Bitboard(hex.m_Bitboard), m_Size(hex.m_Size), m_Empty(hex.m_Empty), m_Hash(hex.m_Hash),
+	m_Player1(hex.m_Player1), m_Player2(hex.m_Player2), m_NextPlayer(hex.m_NextPlayer)
 {
-	m_Player1 = new HumanPlayer(hex.m_Player1->GetColor());
-	m_Player2 = new MonteCarloPlayer(hex.m_Player2->GetColor());
 }
 
-Hex::Hex(Hex &&hex) : m_Size(hex.m_Size), m_Empty(hex.m_Empty), m_HexBoard(move(hex.m_HexBoard)),
-	m_Left(hex.m_Left), m_Right(hex.m_Right), m_Top(hex.m_Top), m_Bottom(hex.m_Bottom), m_NextPlayer(hex.m_NextPlayer)
+Hex::Hex(Hex &&hex) : m_Left(hex.m_Left), m_Right(hex.m_Right), m_Top(hex.m_Top), m_Bottom(hex.m_Bottom), m_BoardType(hex.m_BoardType),
+	m_HexBoard(move(hex.m_HexBoard)), m_Groups(move(hex.m_Groups)), m_Bitboard(hex.m_Bitboard), m_Size(hex.m_Size), m_Empty(hex.m_Empty),
+	m_Hash(hex.m_Hash), m_Player1(move(hex.m_Player1)), m_Player2(move(hex.m_Player2)), m_NextPlayer(hex.m_NextPlayer)
 {
-	m_Player1 = hex.m_Player1;
-	hex.m_Player1 = nullptr;
-	m_Player2 = hex.m_Player2;
-	hex.m_Player2 = nullptr;
 }
 
 Hex::~Hex()
 {
-	delete m_Player1;
-	delete m_Player2;
 }
 
 bool Hex::GetVertexNumber(const string &turn, unsigned int &result) const
@@ -593,6 +1154,10 @@ bool Hex::GetVertexNumber(const string &turn, unsigned int &result) const
 
 void Hex::SetEdgesColors(const coordinates &coord)
 {
+	//  The bitboard updates its connections when the stone is placed
+	if (m_BoardType == BIT_BOARD)
+		return;
+
 	unsigned int vertexIndex = coord.first * m_Size + coord.second;
 
 	const list<Edge> &edges = m_HexBoard.GetNodeEdges(vertexIndex);
@@ -603,6 +1168,7 @@ void Hex::SetEdgesColors(const coordinates &coord)
 		{
 			m_HexBoard.SetEdgeColor(vertexIndex, endHexNumber, m_HexBoard.GetVertexColor(vertexIndex));
 			m_HexBoard.SetEdgeColor(endHexNumber, vertexIndex, m_HexBoard.GetVertexColor(vertexIndex));
+			m_Groups.Union(vertexIndex, endHexNumber);
 		}
 	}
 }
@@ -610,13 +1176,24 @@ void Hex::SetEdgesColors(const coordinates &coord)
 bool Hex::SetVertexColor(const coordinates &coord, PlayerColor playerColor)
 {
 	unsigned int vertexIndex = coord.first * m_Size + coord.second;
+	bool bPlaced;
+
 	m_Empty--;
-	return m_HexBoard.SetVertexColor(vertexIndex, playerColor);
+	if (m_BoardType == BIT_BOARD)
+		bPlaced = m_Bitboard.Place(vertexIndex, playerColor);
+	else
+		bPlaced = m_HexBoard.SetVertexColor(vertexIndex, playerColor);
+
+	if (bPlaced)
+		m_Hash ^= GetZobristKey(vertexIndex, playerColor);
+	return bPlaced;
 }
 
 PlayerColor Hex::GetVertexColor(const coordinates &coord) const
 {
 	unsigned int vertexIndex = coord.first * m_Size + coord.second;
+	if (m_BoardType == BIT_BOARD)
+		return m_Bitboard.GetColor(vertexIndex);
 	return m_HexBoard.GetVertexColor(vertexIndex);
 }
 
@@ -630,82 +1207,107 @@ PlayerColor Hex::GetNextPlayerColor() const
 
 PlayerColor Hex::GetWinner()
 {
+	if (m_BoardType == BIT_BOARD)
+		return m_Bitboard.GetWinner();
+
 	//  BLUE wins if two his virtual vertices are connected (left and right)
-	auto blueVertices = m_HexBoard.GetConnections(m_Left);
-	if (find(blueVertices.begin(), blueVertices.end(), m_Right) != blueVertices.end())
+	if (m_Groups.Connected(m_Left, m_Right))
 		return BLUE;
 
 	//  RED wins if two his virtual vertices are connected (upper and lower)
-	auto redVertices = m_HexBoard.GetConnections(m_Top);
-	if (find(redVertices.begin(), redVertices.end(), m_Bottom) != redVertices.end())
+	if (m_Groups.Connected(m_Top, m_Bottom))
 		return RED;
 
 	return NONE;
 }
 
-PlayerColor Hex::MakeTurn()
+void Hex::MakeMove(const coordinates &coord)
 {
-	IPlayer *currentPlayer;
+	MoveRecord record;
+	record.m_Vertex = coord.first * m_Size + coord.second;
+	record.m_GroupsMark = 0;
+	record.m_Hash = m_Hash;
 
-	if (m_NextPlayer == 1)
-		currentPlayer = m_Player1;
+	if (m_BoardType == BIT_BOARD)
+		m_BitboardHistory.push_back(m_Bitboard);
 	else
-		currentPlayer = m_Player2;
+		record.m_GroupsMark = m_Groups.Checkpoint();
+	m_Moves.push_back(record);
 
-	while (!currentPlayer->TryTurn(*this))
-		cout << *this;
+	SetVertexColor(coord, GetNextPlayerColor());
+	SetEdgesColors(coord);
+	m_NextPlayer = !m_NextPlayer;
+}
 
-	m_NextPlayer = !m_NextPlayer;  //  easy way to change player
+void Hex::UndoMove()
+{
+	const MoveRecord &record = m_Moves.back();
 
-	return GetWinner();
+	if (m_BoardType == BIT_BOARD)
+	{
+		m_Bitboard = m_BitboardHistory.back();
+		m_BitboardHistory.pop_back();
+	}
+	else
+	{
+		//  Edges of the vertex were colored only by this move, all the later moves are already taken back
+		const list<Edge> &edges = m_HexBoard.GetNodeEdges(record.m_Vertex);
+		for (auto it = edges.begin(); it != edges.end(); ++it)
+			if (it->GetEdgeColor() != NONE)
+			{
+				m_HexBoard.SetEdgeColor(record.m_Vertex, it->GetEndVertexNumber(), NONE);
+				m_HexBoard.SetEdgeColor(it->GetEndVertexNumber(), record.m_Vertex, NONE);
+			}
+		m_HexBoard.ResetVertexColor(record.m_Vertex);
+		m_Groups.Rollback(record.m_GroupsMark);
+	}
+
+	m_Hash = record.m_Hash;
+	m_Moves.pop_back();
+	m_Empty++;
+	m_NextPlayer = !m_NextPlayer;
 }
 
-PlayerColor Hex::MakeTurnInSimulation()
+PlayerColor Hex::MakeTurn(bool bVerbose /* = true */)
 {
 	IPlayer *currentPlayer;
 
 	if (m_NextPlayer == 1)
-		currentPlayer = m_Player1;
+		currentPlayer = m_Player1.get();
 	else
-		currentPlayer = m_Player2;
+		currentPlayer = m_Player2.get();
 
 	while (!currentPlayer->TryTurn(*this))
-		continue;
+		if (bVerbose)
+			cout << *this;
 
 	m_NextPlayer = !m_NextPlayer;  //  easy way to change player
 
 	return GetWinner();
 }
 
-PlayerColor Hex::Play()
+PlayerColor Hex::Play(bool bVerbose /* = true */)
 {
 	PlayerColor winner;
 	do
 	{
-		cout << *this;
-		winner = MakeTurn();
+		if (bVerbose)
+			cout << *this;
+		winner = MakeTurn(bVerbose);
 	} while (winner == NONE);
 
-	cout << *this;
+	if (bVerbose)
+		cout << *this;
 
 	return winner;
 }
 
-PlayerColor Hex::RandomSimulation()
+PlayerColor Hex::RandomSimulation() const
 {
-	PlayerColor winner;
+	HexPlayout playout(rand());
 
-	delete m_Player1;
-	delete m_Player2;
-	m_Player1 = new RandomStrategyPlayer(RED);
-	m_Player2 = new RandomStrategyPlayer(BLUE);
-
-	do
-	{
-		winner = MakeTurnInSimulation();
-	} while (winner == NONE);
-
-	return winner;
+	playout.Load(*this);
+	return playout.Play();
 }
 
 //  doesn't support field size > alphabet letters amount
@@ -730,7 +1332,7 @@ ostream &operator<<(ostream &os, const Hex &hexGame)
 
 		for (unsigned int j = 0; j < hexGame.m_Size; ++j)
 		{
-			switch (hexGame.m_HexBoard.GetVertexColor(i*hexGame.m_Size + j))
+			switch (hexGame.GetVertexColor(coordinates(i, j)))
 			{
 			case NONE:
 				os << ".";
@@ -3,28 +3,54 @@
 
 #include <iostream>
 #include <algorithm>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cmath>
 #include "Graph.h"
+#include "DisjointSet.h"
+#include "HexBitboard.h"
+#include "HexPlayout.h"
+#include "HexEvaluator.h"
+#include "TranspositionTable.h"
 
 using std::ostream;
 using std::cin;
 using std::cout;
 using std::endl;
 using std::stoul;
+using std::shared_ptr;
+using std::make_shared;
+using std::thread;
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
 
 typedef pair<unsigned int, unsigned int> coordinates;
 typedef pair<coordinates, int> turn;
 class Hex;
+class Tournament;
+class HexBenchmark;
+
+//  The way the Hex board is stored: the Graph with the vertex per hexagon or the bitmasks
+enum HexBoardType{GRAPH_BOARD, BIT_BOARD};
 
 //  I for Interface
 class IPlayer
 {
 protected:
+	//  Seed of the random generators of a new player. They don't read rand(), which is shared by all the threads
+	static const unsigned int DEFAULT_SEED = 5489;
+
 	PlayerColor m_PlayerColor;
 public:
 	IPlayer(PlayerColor playerColor);
 	virtual ~IPlayer();
 
 	PlayerColor GetColor() const;
+	//  Seed the random generators of the player, a new player always starts with the same seed. Every tournament worker
+	//  seeds its players from its own generator, so its games don't depend on the other threads.
+	//  Players that don't make random decisions ignore it
+	virtual void SetSeed(unsigned int seed);
 
 	virtual bool TryTurn(Hex& hexBoard) = 0;
 };
@@ -42,77 +68,283 @@ public:
 
 class RandomStrategyPlayer : public IPlayer
 {
+private:
+	std::mt19937 m_Random;
 public:
 	RandomStrategyPlayer(PlayerColor playerColor);
 	virtual ~RandomStrategyPlayer();
 	
+	void SetSeed(unsigned int seed);
 	bool TryTurn(Hex &hexBoard);
 };
 
 class IPredictingPlayer : public IPlayer
 {
 protected:
+	//  Value of a won position. Any value with the same magnitude means that the game is decided.
+	//  It is far above any difference of the distances given by the evaluator
+	static const int WIN_VALUE = 100000;
+	//  The clock is read once per this number of searched positions by default
+	static const unsigned int CLOCK_CHECK_NODES = 1024;
+
+	//  Time budget of a move in milliseconds, 0 means no limit
+	unsigned int m_TimeBudget;
+	steady_clock::time_point m_Deadline;
+	//  Depth of the deepest finished iteration of the current move
+	unsigned int m_CompletedDepth;
+	unsigned int m_ClockCounter;
+	//  The number of positions searched between the clock reads. A player with a slow evaluation reads it more often
+	unsigned int m_ClockCheckNodes;
+	bool m_bTimeout;
+	//  Fields to try at every level of the search. They are allocated once per move
+	vector<vector<unsigned short>> m_Fields;
+	HexEvaluator m_Evaluator;
+
 	PlayerColor InverseColor();
+	//  Returns WIN_VALUE for a won game, -WIN_VALUE for a lost one and the evaluation of m_Evaluator otherwise
 	virtual int Evaluate(Hex &hexBoard);
-	void GetPossibleFields(const Hex &hexBoard, vector<Hex> &boards, vector<coordinates> &coords);
+	//  Start the clock of a move and prepare the fields buffers for the board
+	void StartSearch(const Hex &hexBoard);
+	//  Check if the time budget of the move is spent. After that every search function must return at once and
+	//  its result is not valid. The first iteration is never stopped, so there always is a move to make
+	bool IsTimeout();
+	//  Get the empty fields for the level as vertex numbers. firstMove goes first if it is empty,
+	//  the rest follow in the row-major order
+	vector<unsigned short> &GetEmptyFields(const Hex &hexBoard, unsigned int level, unsigned short firstMove);
+	//  Get the next empty field in the row-major order starting from coord. Returns false if there are no more fields.
+	//  Search iterates the moves with it and makes them in place with Hex::MakeMove/UndoMove
+	bool GetNextEmptyField(const Hex &hexBoard, coordinates &coord) const;
+	//  Look up the position in the transposition table. Returns true if the stored result can be returned
+	//  for the window (alpha, beta) and the depth without searching the position again.
+	//  move gets the stored best move of the position, NO_MOVE if there is none
+	bool ProbeTable(TranspositionTable &table, const Hex &hexBoard, unsigned int depth, int alpha, int beta, turn &res,
+		unsigned short &move) const;
+	//  Store the result of a search made with the window (alpha, beta)
+	void StoreTable(TranspositionTable &table, const Hex &hexBoard, unsigned int depth, int alpha, int beta, int value,
+		unsigned short move) const;
 public:
-	IPredictingPlayer(PlayerColor playerColor);
+	IPredictingPlayer(PlayerColor playerColor, unsigned int timeBudget = 0);
 	virtual ~IPredictingPlayer();
 
 	virtual bool TryTurn(Hex& hexBoard) = 0;
+
+	void SetTimeBudget(unsigned int timeBudget) { m_TimeBudget = timeBudget; }
+	unsigned int GetTimeBudget() const { return m_TimeBudget; }
+	unsigned int GetCompletedDepth() const { return m_CompletedDepth; }
+	HexEvaluator &GetEvaluator() { return m_Evaluator; }
 };
 
+//  Both search players deepen the search one level at a time until the time budget of the move is spent
+//  and make the best move of the deepest finished iteration
 class MinMaxPlayer : public IPredictingPlayer
 {
 private:
+	//  Best move of the previous iteration. It is tried first at the root of the next one
+	unsigned short m_RootMove;
+	unsigned int m_RootLevel;
+
 	turn Min(Hex &hexBoard, const coordinates& coord, unsigned int level);
 	turn Max(Hex &hexBoard, const coordinates& coord, unsigned int level);
 public:
-	MinMaxPlayer(PlayerColor playerColor);
+	//  timeBudget is the time of a move in milliseconds
+	MinMaxPlayer(PlayerColor playerColor, unsigned int timeBudget = 1000);
 	virtual ~MinMaxPlayer();
 
 	bool TryTurn(Hex& hexBoard);
 };
 
+//  Min and Max of this player share the transposition table, so every position reached by different move orders
+//  is searched only once. Fields are ordered to get cutoffs as early as possible: the best move stored in the table
+//  goes first (so each iteration starts with the best line of the previous one), then the killer moves of the ply
+//  and then the rest by the history of cutoffs they made. The first field is searched with the full window, the others
+//  with a null window that only proves they are not better. A field that turns out to be better is searched again
 class AlphaBetaPlayer : public IPredictingPlayer
 {
 private:
+	static const unsigned int KILLERS_PER_PLY = 2;
+
+	TranspositionTable m_Table;
+	unsigned int m_RootLevel;
+	//  Fields that made the last cutoffs at every ply, KILLERS_PER_PLY per ply
+	vector<unsigned short> m_Killers;
+	//  Cutoffs made by every field, separately for each color. A cutoff adds the square of the remaining depth
+	vector<unsigned int> m_History;
+	//  Scores of the fields of every level, parallel to m_Fields
+	vector<vector<unsigned int>> m_Scores;
+
+	//  Statistics
+	unsigned long long m_Nodes;
+	unsigned long long m_Cutoffs;
+	unsigned long long m_FirstFieldCutoffs;
+	unsigned long long m_ReSearches;
+	unsigned long long m_IterationNodes;
+
 	turn Min(Hex &hexBoard, const coordinates& coord, int alpha, int beta, unsigned int level);
 	turn Max(Hex &hexBoard, const coordinates& coord, int alpha, int beta, unsigned int level);
+	//  Prepare the ordering buffers after StartSearch. Killer moves are forgotten, the history is aged
+	void StartOrdering(const Hex &hexBoard);
+	//  Get the fields of the level and score them for the ordering
+	vector<unsigned short> &GetOrderedFields(const Hex &hexBoard, unsigned int level, unsigned short tableMove);
+	//  Move the field with the highest score among the fields from i to the end to the position i
+	void PickNextField(unsigned int level, size_t i);
+	//  Remember the field that made a cutoff at the level
+	void StoreCutoff(const Hex &hexBoard, unsigned int level, unsigned short field);
+	unsigned int HistoryIndex(const Hex &hexBoard, unsigned short field) const;
 public:
-	AlphaBetaPlayer(PlayerColor playerColor);
+	//  timeBudget is the time of a move in milliseconds, tableMemory is the memory budget of the transposition table in bytes
+	AlphaBetaPlayer(PlayerColor playerColor, unsigned int timeBudget = 1000, size_t tableMemory = 16 << 20);
 	virtual ~AlphaBetaPlayer();
 
 	bool TryTurn(Hex& hexBoard);
+
+	const TranspositionTable &GetTable() const { return m_Table; }
+
+	//  Number of positions searched
+	unsigned long long GetNodes() const { return m_Nodes; }
+	//  Number of positions where a field made a cutoff
+	unsigned long long GetCutoffs() const { return m_Cutoffs; }
+	//  Number of cutoffs made by the first tried field. The ratio to GetCutoffs shows the quality of the ordering
+	unsigned long long GetFirstFieldCutoffs() const { return m_FirstFieldCutoffs; }
+	//  Number of null window searches that had to be repeated with the full window
+	unsigned long long GetReSearches() const { return m_ReSearches; }
+	//  Effective branching factor of the deepest finished iteration of the last move
+	double GetEffectiveBranchingFactor() const;
+	void ResetStatistics();
 };
 
+//  Searches 2 plies with the value of a leaf given by random playouts. The search of 1 ply goes first,
+//  so there is a move to make when the time budget of the move ends before the second ply is searched
 class MonteCarloAlphaBetaPlayer : public IPredictingPlayer
 {
 private:
+	static const unsigned int MAX_DEPTH = 2;
+
 	unsigned int m_InitialLevel;
+	//  Depth of the current iteration
+	unsigned int m_Depth;
 	unsigned int m_Simulations;
+	HexPlayout m_Playout;
+	TranspositionTable m_Table;
 
 	int Evaluate(Hex &hexBoard);
 	turn Min(Hex &hexBoard, const coordinates& coord, int alpha, int beta, unsigned int level);
 	turn Max(Hex &hexBoard, const coordinates& coord, int alpha, int beta, unsigned int level);
 public:
-	MonteCarloAlphaBetaPlayer(PlayerColor playerColor);
+	//  timeBudget is the time of a move in milliseconds, 0 means no limit.
+	//  tableMemory is the memory budget of the transposition table in bytes
+	MonteCarloAlphaBetaPlayer(PlayerColor playerColor, unsigned int timeBudget = 0, size_t tableMemory = 16 << 20);
 	virtual ~MonteCarloAlphaBetaPlayer();
 
+	void SetSeed(unsigned int seed);
 	bool TryTurn(Hex& hexBoard);
+
+	const TranspositionTable &GetTable() const { return m_Table; }
 };
 
+//  Evaluates every possible field with random simulations. Simulations of each field are split
+//  between m_Threads worker threads. Every worker has its own HexPlayout (board copy and random generator)
+//  and writes wins only to its own vector, so the workers don't need any locks
 class MonteCarloPlayer : public IPredictingPlayer
 {
 private:
 	unsigned int m_Simulations;
+	unsigned int m_Threads;
+	HexPlayout m_Playout;
+	//  Seeds of the playouts of the workers
+	std::mt19937 m_Random;
 
 	int Evaluate(Hex &hexBoard);
+	//  Run the given number of simulations for every field and store the wins of the player
+	void EvaluateFields(const Hex &hexBoard, const vector<unsigned int> &fields, unsigned int simulations, unsigned int seed,
+		vector<unsigned int> &wins) const;
 public:
-	MonteCarloPlayer(PlayerColor playerColor);
+	//  threads == 0 means one thread per hardware core
+	MonteCarloPlayer(PlayerColor playerColor, unsigned int threads = 0);
 	virtual ~MonteCarloPlayer();
 
+	void SetSeed(unsigned int seed);
+	bool TryTurn(Hex& hexBoard);
+};
+
+//  Node of the Monte Carlo search tree. Children of a node are stored one after another in the node pool,
+//  so a node only keeps the index of the first child and the amount of children
+class MctsNode
+{
+public:
+	unsigned int m_Parent;
+	unsigned int m_FirstChild;
+	unsigned int m_Visits;
+	//  Wins of the player who made the move leading to this node
+	unsigned int m_Wins;
+	//  All-moves-as-first statistics: playouts through the parent where the move's cell got the move's color
+	unsigned int m_AmafVisits;
+	unsigned int m_AmafWins;
+	unsigned short m_ChildrenAmount;
+	unsigned short m_Cell;
+	PlayerColor m_Color;
+};
+
+//  Monte Carlo Tree Search player. Each iteration descends the tree choosing children by UCB1,
+//  expands a visited leaf with all the empty cells, finishes the game with a random playout
+//  and updates the statistics of the nodes on the way back to the root.
+//  Since the board of a playout is filled completely, every playout also updates RAVE (all moves as first)
+//  statistics of the siblings, and the value of a rarely visited child is mostly its RAVE value.
+//  Nodes are taken from a pool preallocated in the constructor, so the memory is bounded by m_MaxNodes nodes.
+//  When the pool is exhausted leaves are not expanded anymore, playouts continue from them
+class MonteCarloTreeSearchPlayer : public IPredictingPlayer
+{
+private:
+	unsigned int m_MaxNodes;
+	double m_Exploration;
+	double m_RaveEquivalence;
+	vector<MctsNode> m_Pool;
+	unsigned int m_NodesUsed;
+	unsigned int m_Iterations;
+	HexPlayout m_RootPlayout;
+	HexPlayout m_Playout;
+
+	//  Get the child of the node with the best UCB1 value (mixed with the RAVE value)
+	unsigned int SelectChild(unsigned int node) const;
+	//  Update visits, wins and RAVE statistics from the node up to the root
+	void Backpropagate(unsigned int node, PlayerColor winner);
+	//  Create children for all the empty cells. Returns false if the pool doesn't have enough nodes
+	bool Expand(unsigned int node);
+	//  One iteration: selection, expansion, playout and backpropagation
+	void Iterate();
+public:
+	//  timeBudget is the time of a turn in milliseconds
+	MonteCarloTreeSearchPlayer(PlayerColor playerColor, unsigned int timeBudget = 1000, unsigned int maxNodes = 1 << 20);
+	virtual ~MonteCarloTreeSearchPlayer();
+
+	void SetSeed(unsigned int seed);
 	bool TryTurn(Hex& hexBoard);
+
+	//  Statistics of the last turn
+	unsigned int GetIterations() const { return m_Iterations; }
+	unsigned int GetNodesUsed() const { return m_NodesUsed; }
+	//  Memory of the node pool. It doesn't depend on the amount of iterations
+	size_t GetMemoryUsage() const { return m_Pool.capacity() * sizeof(MctsNode); }
+	static size_t GetBytesPerNode() { return sizeof(MctsNode); }
+};
+
+//  Lower bound of the path length between two vertices of the board graph of Hex (see Hex::GetBoardGraph) with
+//  edges not lighter than minWeight. The vertex i*size + j is the hexagon in the row i and the column j, so
+//  a path between hexagons has at least (|di| + |dj| + |di + dj|) / 2 edges. A path through the virtual vertices
+//  of the sides can be shorter, it has at least the edges from both hexagons to their nearest sides and 2 edges
+//  from and to a virtual vertex. The estimate is 0 if one of the vertices is virtual
+class HexGridHeuristic : public IDistanceHeuristic
+{
+private:
+	unsigned int m_Size;
+	double m_MinWeight;
+
+	//  The number of edges from the hexagon to the virtual vertex of its nearest side
+	unsigned int GetSideDistance(unsigned int row, unsigned int column) const;
+public:
+	HexGridHeuristic(unsigned int size, double minWeight);
+	virtual ~HexGridHeuristic();
+
+	virtual double GetEstimate(unsigned int from, unsigned int to) const;
 };
 
 //  Implements the game of hex. The board is represented as a graph that has size*size vertices(hexagons)
@@ -120,22 +352,50 @@ public:
 //  Each player has two virtual vertices connected to all the vertices on opposite sides of the board
 //  Each virtual vertex represents a side. 
 //  A player wins if he connects his 2 virtual vertices (i.e. opposite sides of the board).
+//  Alternatively the board can be stored as a HexBitboard (see BIT_BOARD). Then the Graph is not built
+//  at all and a copy of the game is cheap. Players and the output work the same way for both boards
 class Hex
 {
 private:
 	//  Virtual vertex indexes
 	const int m_Left, m_Right, m_Top, m_Bottom;
+	HexBoardType m_BoardType;
 	Graph m_HexBoard;
+	//  Connected groups of equally colored vertices (virtual vertices included).
+	//  It is updated on every placed stone so the winner check doesn't have to search the Graph
+	DisjointSet m_Groups;
+	HexBitboard m_Bitboard;
 	unsigned int m_Size;
 	unsigned int m_Empty;
-
-	IPlayer *m_Player1, *m_Player2;
+	//  Zobrist hash of the stones on the board
+	unsigned long long m_Hash;
+
+	//  Undo stack of MakeMove. Graph board keeps the vertex and the mark of the groups forest,
+	//  bitboard keeps the whole position before the move (it is just a few cache lines)
+	class MoveRecord
+	{
+	public:
+		unsigned int m_Vertex;
+		size_t m_GroupsMark;
+		unsigned long long m_Hash;
+	};
+	vector<MoveRecord> m_Moves;
+	vector<HexBitboard> m_BitboardHistory;
+
+	//  Players are shared between copies of the game so copying doesn't allocate them
+	shared_ptr<IPlayer> m_Player1, m_Player2;
 	int m_NextPlayer;
 
+	//  Returns the board type that can be used for the given size (bitboards are limited by HexBitboard::MAX_SIZE)
+	static HexBoardType GetSupportedBoardType(unsigned int size, HexBoardType boardType);
+	//  Adds all the hexagon and virtual vertex edges to the Graph
+	void BuildBoardGraph();
+
 	char GetXCoord(unsigned int xCoord) const;
 	//  Gets vertex number in the Graph from its position on the board
 	bool GetVertexNumber(const string &turn, unsigned int &result) const;
 	//  Colors all the edges coming outta vertex that don't have a color yet
+	//  and merges the vertex with the groups of its neighbors of the same color
 	void SetEdgesColors(const coordinates &coord);
 
 	PlayerColor GetVertexColor(const coordinates &coord) const;
@@ -146,19 +406,33 @@ private:
 	//  Returns the color of the winner if there is one. Otherwise returns NONE (form PlayerColor enum)
 	PlayerColor GetWinner();
 
-	//  Make a turn in the hex game
-	PlayerColor MakeTurn();
+	//  Put a stone of the next player to the empty field in place and pass the turn.
+	//  The move is remembered so it can be taken back by UndoMove. Players use it to search without copying the board
+	void MakeMove(const coordinates &coord);
+	//  Take back the last move made by MakeMove
+	void UndoMove();
+	//  Get the Zobrist hash of the position. It is updated incrementally with every placed stone
+	unsigned long long GetHash() const { return m_Hash; }
 
-	PlayerColor MakeTurnInSimulation();
+	//  Make a turn in the hex game. The board is printed after every failed try of the player if bVerbose is set
+	PlayerColor MakeTurn(bool bVerbose = true);
 public:
-	//  Construct a hex board of given size
-	explicit Hex(unsigned int size);
+	//  Construct a hex board of given size for a human (RED) against the MonteCarloPlayer (BLUE) seeded by rand()
+	explicit Hex(unsigned int size, HexBoardType boardType = GRAPH_BOARD);
+	//  Construct a hex board of given size for the given players. player1 plays RED and makes the first turn
+	Hex(unsigned int size, shared_ptr<IPlayer> player1, shared_ptr<IPlayer> player2, HexBoardType boardType = GRAPH_BOARD);
 	Hex(const Hex& hex);
 	Hex(Hex &&hex);
 	~Hex();
 
-	PlayerColor Play();
-	PlayerColor RandomSimulation();
+	//  Play the game to the end. The board is printed before every turn if bVerbose is set
+	PlayerColor Play(bool bVerbose = true);
+	//  Returns the winner of a random game played from the current position (see HexPlayout)
+	PlayerColor RandomSimulation() const;
+	//  Get the board as a Graph: the hexagon in the row i and the column j is the vertex i*size + j, the virtual
+	//  vertices of the left, right, top and bottom sides follow them. All the edges have 0 weight.
+	//  The graph is empty for the BIT_BOARD, it doesn't build the Graph
+	const Graph &GetBoardGraph() const { return m_HexBoard; }
 
 	//  Outputs the hex board
 	friend ostream &operator<< (ostream &os, const Hex &hexGame);
@@ -170,6 +444,11 @@ public:
 	friend AlphaBetaPlayer;
 	friend MonteCarloAlphaBetaPlayer;
 	friend MonteCarloPlayer;
+	friend MonteCarloTreeSearchPlayer;
+	friend HexPlayout;
+	friend HexEvaluator;
+	friend Tournament;
+	friend HexBenchmark;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+///  Contains the bit-packed Hex position implementation
+#include "HexBitboard.h"
+#include <climits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#pragma intrinsic(_BitScanForward64)
+#endif
+
+//  Get the index of the lowest set bit. The value must not be 0
+static unsigned int LowestBit(unsigned long long value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return index;
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+void BoardMask::Clear()
+{
+	for (unsigned int i = 0; i < WORDS; ++i)
+		m_Words[i] = 0;
+}
+
+bool BoardMask::Empty() const
+{
+	for (unsigned int i = 0; i < WORDS; ++i)
+		if (m_Words[i])
+			return false;
+	return true;
+}
+
+bool BoardMask::Intersects(const BoardMask &mask) const
+{
+	for (unsigned int i = 0; i < WORDS; ++i)
+		if (m_Words[i] & mask.m_Words[i])
+			return true;
+	return false;
+}
+
+unsigned int BoardMask::PopFirst()
+{
+	for (unsigned int i = 0; i < WORDS; ++i)
+		if (m_Words[i])
+		{
+			unsigned int bit = LowestBit(m_Words[i]);
+			m_Words[i] &= m_Words[i] - 1;  //  clears the lowest set bit
+			return i * WORD_BITS + bit;
+		}
+	return UINT_MAX;
+}
+
+BoardMask BoardMask::AndNot(const BoardMask &mask) const
+{
+	BoardMask result;
+	for (unsigned int i = 0; i < WORDS; ++i)
+		result.m_Words[i] = m_Words[i] & ~mask.m_Words[i];
+	return result;
+}
+
+BoardMask BoardMask::operator&(const BoardMask &mask) const
+{
+	BoardMask result;
+	for (unsigned int i = 0; i < WORDS; ++i)
+		result.m_Words[i] = m_Words[i] & mask.m_Words[i];
+	return result;
+}
+
+BoardMask &BoardMask::operator|=(const BoardMask &mask)
+{
+	for (unsigned int i = 0; i < WORDS; ++i)
+		m_Words[i] |= mask.m_Words[i];
+	return *this;
+}
+
+BoardMask &BoardMask::operator&=(const BoardMask &mask)
+{
+	for (unsigned int i = 0; i < WORDS; ++i)
+		m_Words[i] &= mask.m_Words[i];
+	return *this;
+}
+
+HexBoardTables::HexBoardTables() : m_Size(0)
+{
+}
+
+//  Neighbors of the cell (i, j) are the same as the edges built by the Hex constructor:
+//  (i - 1, j), (i - 1, j + 1), (i, j - 1), (i, j + 1), (i + 1, j - 1) and (i + 1, j)
+HexBoardTables::HexBoardTables(unsigned int size) : m_Size(size), m_Neighbors(size*size)
+{
+	const int di[] = { -1, -1, 0, 0, 1, 1 };
+	const int dj[] = { 0, 1, -1, 1, -1, 0 };
+	int n = size;
+
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+		{
+			BoardMask &neighbors = m_Neighbors[i*n + j];
+			for (unsigned int k = 0; k < 6; ++k)
+			{
+				int ni = i + di[k], nj = j + dj[k];
+				if (ni >= 0 && ni < n && nj >= 0 && nj < n)
+					neighbors.Set(ni*n + nj);
+			}
+		}
+
+	for (unsigned int i = 0; i < size; ++i)
+	{
+		m_Top.Set(i);
+		m_Bottom.Set((size - 1)*size + i);
+		m_Left.Set(i*size);
+		m_Right.Set(i*size + size - 1);
+	}
+}
+
+//  Build the tables for all the supported sizes. Index of the element equals the board size
+static vector<HexBoardTables> BuildAllTables()
+{
+	vector<HexBoardTables> tables(HexBitboard::MAX_SIZE + 1);
+	for (unsigned int i = 1; i <= HexBitboard::MAX_SIZE; ++i)
+		tables[i] = HexBoardTables(i);
+	return tables;
+}
+
+const HexBoardTables *HexBoardTables::Get(unsigned int size)
+{
+	//  Static local is initialized once on the first call (and thread safe since C++11)
+	static const vector<HexBoardTables> tables = BuildAllTables();
+
+	if (size == 0 || size > HexBitboard::MAX_SIZE)
+		return nullptr;
+	return &tables[size];
+}
+
+HexBitboard::HexBitboard(unsigned int size) : m_Tables(HexBoardTables::Get(size)), m_Winner(NONE)
+{
+}
+
+PlayerColor HexBitboard::GetColor(unsigned int cell) const
+{
+	if (m_Stones[0].Test(cell))
+		return RED;
+	if (m_Stones[1].Test(cell))
+		return BLUE;
+	return NONE;
+}
+
+bool HexBitboard::Place(unsigned int cell, PlayerColor playerColor)
+{
+	if (m_Stones[0].Test(cell) || m_Stones[1].Test(cell))
+		return false;
+
+	unsigned int color = ColorIndex(playerColor);
+	BoardMask &stones = m_Stones[color];
+	BoardMask &connected = m_Connected[color];
+	stones.Set(cell);
+
+	//  The new stone extends the connected chain only if it is on the first side or touches the chain
+	if (!m_Tables->GetFirstSide(playerColor).Test(cell) && !m_Tables->GetNeighbors(cell).Intersects(connected))
+		return true;
+
+	//  Flood fill through the stones of the player that are not connected yet
+	BoardMask frontier;
+	frontier.Set(cell);
+	connected.Set(cell);
+	while (!frontier.Empty())
+	{
+		unsigned int v = frontier.PopFirst();
+		BoardMask next = (m_Tables->GetNeighbors(v) & stones).AndNot(connected);
+		connected |= next;
+		frontier |= next;
+	}
+
+	if (m_Winner == NONE && connected.Intersects(m_Tables->GetSecondSide(playerColor)))
+		m_Winner = playerColor;
+
+	return true;
+}
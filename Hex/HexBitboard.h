@@ -0,0 +1,94 @@
+///  Contains the bit-packed Hex position declaration
+
+#ifndef HEX_BITBOARD_H__
+#define HEX_BITBOARD_H__
+
+#include "Graph.h"
+
+//  This class implements a set of board cells packed into a fixed array of bits.
+//  Cell number is row * size + column, the same as the vertex number in the Hex Graph.
+//  It is big enough for boards up to 19x19 (361 cells)
+class BoardMask
+{
+public:
+	static const unsigned int WORDS = 6;
+	static const unsigned int WORD_BITS = 64;
+private:
+	unsigned long long m_Words[WORDS];
+public:
+	//  defining methods bodies inside the class because they are simple and used on the hot path
+	BoardMask() { Clear(); }
+
+	void Clear();
+	bool Test(unsigned int cell) const { return (m_Words[cell / WORD_BITS] >> (cell % WORD_BITS)) & 1; }
+	void Set(unsigned int cell) { m_Words[cell / WORD_BITS] |= 1ULL << (cell % WORD_BITS); }
+	void Reset(unsigned int cell) { m_Words[cell / WORD_BITS] &= ~(1ULL << (cell % WORD_BITS)); }
+
+	//  Checks if there are no cells in the mask
+	bool Empty() const;
+	//  Checks if the masks have at least one common cell
+	bool Intersects(const BoardMask &mask) const;
+	//  Removes the lowest cell from the mask and returns its number. The mask must not be empty
+	unsigned int PopFirst();
+	//  Returns the cells of this mask that are not in the given mask
+	BoardMask AndNot(const BoardMask &mask) const;
+
+	BoardMask operator&(const BoardMask &mask) const;
+	BoardMask &operator|=(const BoardMask &mask);
+	BoardMask &operator&=(const BoardMask &mask);
+};
+
+//  Precomputed masks for one board size: neighbors of every cell and the four sides of the board.
+//  Tables for all the supported sizes are built once and shared by all the positions
+class HexBoardTables
+{
+private:
+	unsigned int m_Size;
+	vector<BoardMask> m_Neighbors;
+	BoardMask m_Top, m_Bottom, m_Left, m_Right;
+public:
+	HexBoardTables();
+	explicit HexBoardTables(unsigned int size);
+
+	//  Get the tables for the given board size (1..HexBitboard::MAX_SIZE)
+	static const HexBoardTables *Get(unsigned int size);
+
+	unsigned int GetSize() const { return m_Size; }
+	const BoardMask &GetNeighbors(unsigned int cell) const { return m_Neighbors[cell]; }
+	//  The side a player starts his chain from: top for RED, left for BLUE
+	const BoardMask &GetFirstSide(PlayerColor playerColor) const { return playerColor == RED ? m_Top : m_Left; }
+	//  The side a player has to reach to win: bottom for RED, right for BLUE
+	const BoardMask &GetSecondSide(PlayerColor playerColor) const { return playerColor == RED ? m_Bottom : m_Right; }
+};
+
+//  This class implements a Hex position as bitmasks. It is an alternative to the Graph based board:
+//  a copy of it is a few cache lines and doesn't allocate anything.
+//  Each player has two masks: his stones and his stones connected to his first side of the board.
+//  The second mask is grown by a flood fill when a stone is placed, so a winner is known right after the move
+class HexBitboard
+{
+public:
+	static const unsigned int MAX_SIZE = 19;
+private:
+	const HexBoardTables *m_Tables;
+	BoardMask m_Stones[2];
+	BoardMask m_Connected[2];
+	PlayerColor m_Winner;
+
+	static unsigned int ColorIndex(PlayerColor playerColor) { return playerColor == RED ? 0 : 1; }
+public:
+	//  Construct an empty position. Size 0 constructs a placeholder that can't hold stones
+	explicit HexBitboard(unsigned int size);
+
+	unsigned int GetSize() const { return m_Tables ? m_Tables->GetSize() : 0; }
+	PlayerColor GetColor(unsigned int cell) const;
+	const BoardMask &GetStones(PlayerColor playerColor) const { return m_Stones[ColorIndex(playerColor)]; }
+	const HexBoardTables &GetTables() const { return *m_Tables; }
+	//  Returns the color of the winner if there is one. Otherwise returns NONE
+	PlayerColor GetWinner() const { return m_Winner; }
+
+	//  Put a stone to the cell. Returns false if the cell is already occupied
+	bool Place(unsigned int cell, PlayerColor playerColor);
+};
+
+#endif
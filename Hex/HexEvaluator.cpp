@@ -0,0 +1,288 @@
+///  Contains the static position evaluator implementation
+#include "HexEvaluator.h"
+#include "Hex.h"
+
+HexEvaluator::HexEvaluator(EvaluationType type /* = SHORTEST_DISTANCE */) : m_Type(type), m_Size(0), m_Stamp(0)
+{
+}
+
+HexEvaluator::~HexEvaluator()
+{
+}
+
+void HexEvaluator::Load(const Hex &hexBoard)
+{
+	const int di[] = { -1, -1, 0, 0, 1, 1 };
+	const int dj[] = { 0, 1, -1, 1, -1, 0 };
+
+	if (m_Size != hexBoard.m_Size)
+	{
+		int n = hexBoard.m_Size;
+		unsigned int cells = n * n;
+
+		m_Size = n;
+		m_Board.resize(cells);
+		m_Neighbors.resize(6 * cells);
+		for (int i = 0; i < n; ++i)
+			for (int j = 0; j < n; ++j)
+				for (unsigned int k = 0; k < 6; ++k)
+				{
+					int ni = i + di[k], nj = j + dj[k];
+					m_Neighbors[6 * (i*n + j) + k] = ni >= 0 && ni < n && nj >= 0 && nj < n ? ni*n + nj : NO_CELL;
+				}
+
+		m_Distance.resize(cells);
+		m_Current.reserve(6 * cells);
+		m_Next.reserve(6 * cells);
+		m_Group.resize(cells);
+		m_GroupStart.reserve(cells + 1);
+		m_GroupNeighbors.reserve(6 * cells);
+		m_GroupSides.reserve(cells);
+		m_Count.resize(cells);
+		m_Mark.assign(cells, 0);
+		m_Stamp = 0;
+	}
+
+	for (unsigned int i = 0; i < m_Size; ++i)
+		for (unsigned int j = 0; j < m_Size; ++j)
+			m_Board[i*m_Size + j] = hexBoard.GetVertexColor(coordinates(i, j));
+}
+
+unsigned int HexEvaluator::NextStamp()
+{
+	if (++m_Stamp == 0)  //  the stamp wrapped around, old marks have to be cleared
+	{
+		std::fill(m_Mark.begin(), m_Mark.end(), 0);
+		m_Stamp = 1;
+	}
+	return m_Stamp;
+}
+
+//  RED connects the top and the bottom, BLUE connects the left and the right side
+bool HexEvaluator::IsFirstSide(unsigned int cell, PlayerColor playerColor) const
+{
+	return playerColor == RED ? cell < m_Size : cell % m_Size == 0;
+}
+
+bool HexEvaluator::IsSecondSide(unsigned int cell, PlayerColor playerColor) const
+{
+	return playerColor == RED ? cell >= m_Size * (m_Size - 1) : cell % m_Size == m_Size - 1;
+}
+
+unsigned int HexEvaluator::GetShortestDistance(PlayerColor playerColor)
+{
+	unsigned int cells = m_Size * m_Size;
+	unsigned int distance = 0;
+
+	std::fill(m_Distance.begin(), m_Distance.end(), NO_CELL);
+	m_Current.clear();
+	m_Next.clear();
+	for (unsigned int cell = 0; cell < cells; ++cell)
+	{
+		if (!IsFirstSide(cell, playerColor) || (m_Board[cell] != NONE && m_Board[cell] != playerColor))
+			continue;
+
+		m_Distance[cell] = m_Board[cell] == playerColor ? 0 : 1;
+		(m_Board[cell] == playerColor ? m_Current : m_Next).push_back(cell);
+	}
+
+	//  m_Current holds the cells with the distance being processed. Own stones don't increase the distance,
+	//  so they are added to it, empty cells go to m_Next. A cell can be added again with a smaller distance,
+	//  the old entry is skipped then
+	while (!m_Current.empty() || !m_Next.empty())
+	{
+		if (m_Current.empty())
+		{
+			m_Current.swap(m_Next);
+			distance++;
+			continue;
+		}
+
+		unsigned int cell = m_Current.back();
+		m_Current.pop_back();
+		if (m_Distance[cell] != distance)
+			continue;
+		if (IsSecondSide(cell, playerColor))
+			return distance;
+
+		for (unsigned int k = 0; k < 6; ++k)
+		{
+			unsigned int next = m_Neighbors[6 * cell + k];
+			if (next == NO_CELL || (m_Board[next] != NONE && m_Board[next] != playerColor))
+				continue;
+
+			unsigned int cost = m_Board[next] == playerColor ? 0 : 1;
+			if (distance + cost < m_Distance[next])
+			{
+				m_Distance[next] = distance + cost;
+				(cost == 0 ? m_Current : m_Next).push_back(next);
+			}
+		}
+	}
+
+	return cells;
+}
+
+bool HexEvaluator::BuildGroups(PlayerColor playerColor)
+{
+	unsigned int cells = m_Size * m_Size;
+
+	std::fill(m_Group.begin(), m_Group.end(), NO_CELL);
+	m_GroupStart.clear();
+	m_GroupNeighbors.clear();
+	m_GroupSides.clear();
+
+	for (unsigned int start = 0; start < cells; ++start)
+	{
+		if (m_Board[start] != playerColor || m_Group[start] != NO_CELL)
+			continue;
+
+		unsigned int group = m_GroupSides.size();
+		unsigned int stamp = NextStamp();
+		unsigned char sides = 0;
+
+		m_GroupStart.push_back(m_GroupNeighbors.size());
+		m_Group[start] = group;
+		m_Current.clear();
+		m_Current.push_back(start);
+		while (!m_Current.empty())
+		{
+			unsigned int cell = m_Current.back();
+			m_Current.pop_back();
+
+			sides |= (IsFirstSide(cell, playerColor) ? 1 : 0) | (IsSecondSide(cell, playerColor) ? 2 : 0);
+			for (unsigned int k = 0; k < 6; ++k)
+			{
+				unsigned int next = m_Neighbors[6 * cell + k];
+				if (next == NO_CELL)
+					continue;
+				if (m_Board[next] == playerColor && m_Group[next] == NO_CELL)
+				{
+					m_Group[next] = group;
+					m_Current.push_back(next);
+				}
+				else if (m_Board[next] == NONE && m_Mark[next] != stamp)
+				{
+					m_Mark[next] = stamp;
+					m_GroupNeighbors.push_back(next);
+				}
+			}
+		}
+
+		if (sides == 3)
+			return true;
+		m_GroupSides.push_back(sides);
+	}
+
+	m_GroupStart.push_back(m_GroupNeighbors.size());
+	return false;
+}
+
+unsigned char HexEvaluator::GetContractedSides(unsigned int cell, PlayerColor playerColor) const
+{
+	unsigned char sides = (IsFirstSide(cell, playerColor) ? 1 : 0) | (IsSecondSide(cell, playerColor) ? 2 : 0);
+
+	for (unsigned int k = 0; k < 6; ++k)
+	{
+		unsigned int next = m_Neighbors[6 * cell + k];
+		if (next != NO_CELL && m_Board[next] == playerColor)
+			sides |= m_GroupSides[m_Group[next]];
+	}
+
+	return sides;
+}
+
+template<typename Action> void HexEvaluator::ForEachContractedNeighbor(unsigned int cell, PlayerColor playerColor, Action action)
+{
+	unsigned int stamp = NextStamp();
+
+	m_Mark[cell] = stamp;
+	for (unsigned int k = 0; k < 6; ++k)
+	{
+		unsigned int next = m_Neighbors[6 * cell + k];
+		if (next == NO_CELL)
+			continue;
+
+		if (m_Board[next] == NONE && m_Mark[next] != stamp)
+		{
+			m_Mark[next] = stamp;
+			action(next);
+		}
+		else if (m_Board[next] == playerColor)
+		{
+			//  Every empty cell around the group is a neighbor of the cell
+			unsigned int group = m_Group[next];
+			for (unsigned int i = m_GroupStart[group]; i < m_GroupStart[group + 1]; ++i)
+				if (m_Mark[m_GroupNeighbors[i]] != stamp)
+				{
+					m_Mark[m_GroupNeighbors[i]] = stamp;
+					action(m_GroupNeighbors[i]);
+				}
+		}
+	}
+}
+
+unsigned int HexEvaluator::GetTwoDistance(PlayerColor playerColor)
+{
+	unsigned int cells = m_Size * m_Size;
+	unsigned int distance = 1;
+	unsigned int reached = 0;
+
+	if (BuildGroups(playerColor))
+		return 0;
+
+	std::fill(m_Distance.begin(), m_Distance.end(), NO_CELL);
+	std::fill(m_Count.begin(), m_Count.end(), 0);
+	m_Current.clear();
+	m_Next.clear();
+	for (unsigned int cell = 0; cell < cells; ++cell)
+		if (m_Board[cell] == NONE && (GetContractedSides(cell, playerColor) & 1))
+		{
+			m_Distance[cell] = 1;
+			m_Current.push_back(cell);
+		}
+
+	//  Cells are taken in the order of their distances, so the second taken neighbor of a cell
+	//  has the second smallest distance. The second side is reached when two cells next to it are taken
+	while (!m_Current.empty() || !m_Next.empty())
+	{
+		if (m_Current.empty())
+		{
+			m_Current.swap(m_Next);
+			distance++;
+			continue;
+		}
+
+		unsigned int cell = m_Current.back();
+		m_Current.pop_back();
+		if ((GetContractedSides(cell, playerColor) & 2) && ++reached == 2)
+			return distance;
+
+		ForEachContractedNeighbor(cell, playerColor, [this, distance](unsigned int next)
+		{
+			if (m_Distance[next] == NO_CELL && ++m_Count[next] == 2)
+			{
+				m_Distance[next] = distance + 1;
+				m_Next.push_back(next);
+			}
+		});
+	}
+
+	return cells;
+}
+
+unsigned int HexEvaluator::GetDistance(const Hex &hexBoard, PlayerColor playerColor)
+{
+	Load(hexBoard);
+	return m_Type == TWO_DISTANCE ? GetTwoDistance(playerColor) : GetShortestDistance(playerColor);
+}
+
+int HexEvaluator::Evaluate(const Hex &hexBoard, PlayerColor playerColor)
+{
+	PlayerColor opponentColor = playerColor == RED ? BLUE : RED;
+
+	Load(hexBoard);
+	if (m_Type == TWO_DISTANCE)
+		return static_cast<int>(GetTwoDistance(opponentColor)) - static_cast<int>(GetTwoDistance(playerColor));
+	return static_cast<int>(GetShortestDistance(opponentColor)) - static_cast<int>(GetShortestDistance(playerColor));
+}
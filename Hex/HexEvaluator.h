@@ -0,0 +1,72 @@
+///  Contains the static position evaluator declaration
+
+#ifndef HEX_EVALUATOR_H__
+#define HEX_EVALUATOR_H__
+
+#include "Graph.h"
+#include <climits>
+
+class Hex;
+
+//  SHORTEST_DISTANCE is the number of stones a player still needs to connect the sides.
+//  TWO_DISTANCE counts a cell only if it can be reached in two ways, so a single blocked path doesn't look short
+enum EvaluationType{SHORTEST_DISTANCE, TWO_DISTANCE};
+
+//  This class implements a static evaluation of hex positions. The distance of a player is computed
+//  with a 0-1 BFS over the cells: own stones cost 0, empty cells cost 1 and opponent's stones are blocked.
+//  The two-distance contracts own groups of stones and gives an empty cell the second smallest value
+//  of its neighbors + 1 (cells next to the starting side get 1).
+//  All the buffers are allocated when the board size changes, so the evaluation doesn't allocate anything
+class HexEvaluator
+{
+private:
+	static const unsigned int NO_CELL = UINT_MAX;
+
+	EvaluationType m_Type;
+	unsigned int m_Size;
+	vector<PlayerColor> m_Board;
+	//  Six neighbors of every cell, NO_CELL where the board ends
+	vector<unsigned int> m_Neighbors;
+	vector<unsigned int> m_Distance;
+	//  Cells with the current distance and the next one
+	vector<unsigned int> m_Current;
+	vector<unsigned int> m_Next;
+
+	//  Own groups of the two-distance. m_GroupNeighbors lists the empty cells around the group g
+	//  from m_GroupStart[g] to m_GroupStart[g + 1]
+	vector<unsigned int> m_Group;
+	vector<unsigned int> m_GroupStart;
+	vector<unsigned int> m_GroupNeighbors;
+	vector<unsigned char> m_GroupSides;
+	vector<unsigned char> m_Count;
+	//  A cell is marked if its mark equals m_Stamp, so the marks don't have to be cleared
+	vector<unsigned int> m_Mark;
+	unsigned int m_Stamp;
+
+	void Load(const Hex &hexBoard);
+	unsigned int NextStamp();
+	bool IsFirstSide(unsigned int cell, PlayerColor playerColor) const;
+	bool IsSecondSide(unsigned int cell, PlayerColor playerColor) const;
+	unsigned int GetShortestDistance(PlayerColor playerColor);
+	unsigned int GetTwoDistance(PlayerColor playerColor);
+	//  Find the own groups of the player, their sides and the empty cells around them.
+	//  Returns true if a group already connects both sides
+	bool BuildGroups(PlayerColor playerColor);
+	//  Get the sides the empty cell touches directly or through an own group: 1 is the first side, 2 is the second one
+	unsigned char GetContractedSides(unsigned int cell, PlayerColor playerColor) const;
+	//  Call action for every empty neighbor of the empty cell in the board where the own groups are contracted
+	template<typename Action> void ForEachContractedNeighbor(unsigned int cell, PlayerColor playerColor, Action action);
+public:
+	explicit HexEvaluator(EvaluationType type = SHORTEST_DISTANCE);
+	~HexEvaluator();
+
+	//  Get the distance of the player on the board. A player that can't connect the sides gets the number of cells
+	unsigned int GetDistance(const Hex &hexBoard, PlayerColor playerColor);
+	//  Get the distance of the opponent minus the distance of the player, so the value is positive when the player is closer
+	int Evaluate(const Hex &hexBoard, PlayerColor playerColor);
+
+	EvaluationType GetType() const { return m_Type; }
+	void SetType(EvaluationType type) { m_Type = type; }
+};
+
+#endif
@@ -0,0 +1,151 @@
+///  Contains the random playout engine implementation
+#include "HexPlayout.h"
+#include "Hex.h"
+#include <chrono>
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+HexPlayout::HexPlayout(unsigned int seed) : m_Size(0), m_Stamp(0), m_NextColor(NONE), m_Random(seed), m_Playouts(0), m_Seconds(0.0)
+{
+}
+
+HexPlayout::~HexPlayout()
+{
+}
+
+void HexPlayout::Load(const Hex &hexBoard)
+{
+	coordinates coord;
+
+	m_Size = hexBoard.m_Size;
+	m_NextColor = hexBoard.GetNextPlayerColor();
+	m_Start.resize(m_Size*m_Size);
+	m_Board.resize(m_Size*m_Size);
+	m_Stack.reserve(m_Size*m_Size);
+	m_Visited.resize(m_Size*m_Size, 0);
+	m_EmptyCells.resize(0);
+
+	for (coord.first = 0; coord.first < m_Size; ++coord.first)
+		for (coord.second = 0; coord.second < m_Size; ++coord.second)
+		{
+			unsigned int cell = coord.first * m_Size + coord.second;
+			m_Start[cell] = hexBoard.GetVertexColor(coord);
+			if (m_Start[cell] == NONE)
+				m_EmptyCells.push_back(cell);
+		}
+}
+
+void HexPlayout::LoadPosition(const HexPlayout &playout)
+{
+	//  vectors keep their capacity, so the copy doesn't allocate after the first time
+	m_Size = playout.m_Size;
+	m_NextColor = playout.m_NextColor;
+	m_Start = playout.m_Start;
+	m_Board.resize(m_Size*m_Size);
+	m_Stack.reserve(m_Size*m_Size);
+	m_Visited.resize(m_Size*m_Size, 0);
+	m_EmptyCells = playout.m_EmptyCells;
+}
+
+void HexPlayout::Place(unsigned int cell, PlayerColor playerColor)
+{
+	m_Start[cell] = playerColor;
+	m_NextColor = playerColor == RED ? BLUE : RED;
+
+	//  Order of the empty cells doesn't matter, so the cell is replaced with the last one
+	for (auto it = m_EmptyCells.begin(); it != m_EmptyCells.end(); ++it)
+		if (*it == cell)
+		{
+			*it = m_EmptyCells.back();
+			m_EmptyCells.pop_back();
+			return;
+		}
+}
+
+PlayerColor HexPlayout::Play()
+{
+	PlayerColor color = m_NextColor;
+
+	m_Board = m_Start;  //  same size, so the vector doesn't reallocate
+	//  Fisher-Yates shuffle, each cell gets the color as it is taken
+	for (size_t i = m_EmptyCells.size(); i > 0; --i)
+	{
+		size_t j = std::uniform_int_distribution<size_t>(0, i - 1)(m_Random);
+		std::swap(m_EmptyCells[i - 1], m_EmptyCells[j]);
+		m_Board[m_EmptyCells[i - 1]] = color;
+		color = color == RED ? BLUE : RED;
+	}
+
+	return GetFullBoardWinner();
+}
+
+//  The board is full, so if RED doesn't connect top and bottom then BLUE connects left and right
+PlayerColor HexPlayout::GetFullBoardWinner()
+{
+	const int di[] = { -1, -1, 0, 0, 1, 1 };
+	const int dj[] = { 0, 1, -1, 1, -1, 0 };
+	int n = m_Size;
+
+	m_Stack.resize(0);
+	if (++m_Stamp == 0)  //  the stamp wrapped around, old marks have to be cleared
+	{
+		std::fill(m_Visited.begin(), m_Visited.end(), 0);
+		m_Stamp = 1;
+	}
+	for (unsigned int j = 0; j < m_Size; ++j)
+		if (m_Board[j] == RED)
+		{
+			m_Visited[j] = m_Stamp;
+			m_Stack.push_back(j);
+		}
+
+	while (!m_Stack.empty())
+	{
+		int cell = m_Stack.back();
+		m_Stack.pop_back();
+
+		int i = cell / n, j = cell % n;
+		if (i == n - 1)
+			return RED;
+
+		for (unsigned int k = 0; k < 6; ++k)
+		{
+			int ni = i + di[k], nj = j + dj[k];
+			if (ni >= 0 && ni < n && nj >= 0 && nj < n && m_Board[ni*n + nj] == RED && m_Visited[ni*n + nj] != m_Stamp)
+			{
+				m_Visited[ni*n + nj] = m_Stamp;
+				m_Stack.push_back(ni*n + nj);
+			}
+		}
+	}
+
+	return BLUE;
+}
+
+unsigned int HexPlayout::Run(unsigned int playouts, PlayerColor playerColor)
+{
+	unsigned int wins = 0;
+	steady_clock::time_point start = steady_clock::now();
+
+	for (unsigned int i = 0; i < playouts; ++i)
+		if (Play() == playerColor)
+			wins++;
+
+	m_Seconds += duration<double>(steady_clock::now() - start).count();
+	m_Playouts += playouts;
+	return wins;
+}
+
+double HexPlayout::GetPlayoutsPerSecond() const
+{
+	if (m_Seconds <= 0.0)
+		return 0.0;
+	return m_Playouts / m_Seconds;
+}
+
+void HexPlayout::ResetStatistics()
+{
+	m_Playouts = 0;
+	m_Seconds = 0.0;
+}
@@ -0,0 +1,70 @@
+///  Contains the random playout engine declaration
+
+#ifndef HEX_PLAYOUT_H__
+#define HEX_PLAYOUT_H__
+
+#include "Graph.h"
+#include <random>
+
+class Hex;
+
+//  This class implements random playouts of the game of hex.
+//  Hex can't end in a draw, so instead of making random turns and checking for a winner after each of them
+//  a playout shuffles the empty cells once, fills the whole board with alternating colors
+//  and checks for a winner only once. All the buffers are allocated when a position is loaded,
+//  so the playouts themselves don't allocate anything.
+//  The engine has its own random generator, so engines in different threads don't share any state
+class HexPlayout
+{
+private:
+	unsigned int m_Size;
+	//  Loaded position and the board of the current playout. Index is the vertex number of the cell
+	vector<PlayerColor> m_Start;
+	vector<PlayerColor> m_Board;
+	vector<unsigned int> m_EmptyCells;
+	//  Stack and visited marks of the flood fill used to find a winner.
+	//  A cell is visited if its mark equals m_Stamp, so the marks don't have to be cleared for each playout
+	vector<unsigned int> m_Stack;
+	vector<unsigned int> m_Visited;
+	unsigned int m_Stamp;
+	PlayerColor m_NextColor;
+	std::mt19937 m_Random;
+
+	//  Statistics
+	unsigned long long m_Playouts;
+	double m_Seconds;
+
+	//  Returns the winner of the completely filled m_Board
+	PlayerColor GetFullBoardWinner();
+public:
+	explicit HexPlayout(unsigned int seed);
+	~HexPlayout();
+
+	//  Restart the random generator with the seed
+	void SetSeed(unsigned int seed) { m_Random.seed(seed); }
+
+	//  Load the position and the player to move from the game
+	void Load(const Hex &hexBoard);
+	//  Copy the loaded position of another engine. Random generator and statistics are not copied
+	void LoadPosition(const HexPlayout &playout);
+	//  Put a stone to an empty cell of the loaded position. The other player moves next
+	void Place(unsigned int cell, PlayerColor playerColor);
+
+	unsigned int GetSize() const { return m_Size; }
+	PlayerColor GetNextColor() const { return m_NextColor; }
+	const vector<unsigned int> &GetEmptyCells() const { return m_EmptyCells; }
+	//  The completely filled board of the last playout
+	const vector<PlayerColor> &GetBoard() const { return m_Board; }
+
+	//  Play one random game from the loaded position and return the winner
+	PlayerColor Play();
+	//  Play the given amount of random games from the loaded position. Returns the number of wins of the player
+	unsigned int Run(unsigned int playouts, PlayerColor playerColor);
+
+	//  Get the number of playouts made by Run and their speed
+	unsigned long long GetPlayouts() const { return m_Playouts; }
+	double GetPlayoutsPerSecond() const;
+	void ResetStatistics();
+};
+
+#endif
@@ -0,0 +1,179 @@
+///  Contains the shortest path algorithm for graphs with integer weights implementation
+#include "IntegerShortestPath.h"
+#include <algorithm>
+
+const unsigned int IntegerShortestPathAlgorithm::MAX_BUCKET_WEIGHT;
+
+IntegerShortestPathAlgorithm::IntegerShortestPathAlgorithm() : m_Stamp(0), m_SettledVertices(0)
+{
+}
+
+IntegerShortestPathAlgorithm::~IntegerShortestPathAlgorithm()
+{
+}
+
+void IntegerShortestPathAlgorithm::Reset(unsigned int size)
+{
+	if (m_Settled.size() < size)
+	{
+		m_Distance.resize(size);
+		m_Reached.resize(size, 0);
+		m_Settled.resize(size, 0);
+	}
+
+	//  All the stamps are cleared once in 4 billion searches, when the stamp wraps around
+	if (++m_Stamp == 0)
+	{
+		fill(m_Reached.begin(), m_Reached.end(), 0);
+		fill(m_Settled.begin(), m_Settled.end(), 0);
+		m_Stamp = 1;
+	}
+	m_SettledVertices = 0;
+}
+
+template<typename TVisit>
+void IntegerShortestPathAlgorithm::Search(const CompactGraph &G, unsigned int u, TVisit visit)
+{
+	Reset(G.GetVerticesAmount());
+	m_Reached[u] = m_Stamp;
+	m_Distance[u] = 0;
+
+	if (G.GetMaxIntegerWeight() <= 1)
+		SearchZeroOne(G, u, visit);
+	else
+		SearchBuckets(G, u, visit);
+}
+
+template<typename TVisit>
+void IntegerShortestPathAlgorithm::SearchZeroOne(const CompactGraph &G, unsigned int u, TVisit visit)
+{
+	m_Deque.clear();
+	m_Deque.push_back(u);
+
+	while (!m_Deque.empty())
+	{
+		unsigned int vertex = m_Deque.front();
+		m_Deque.pop_front();
+
+		//  A vertex can be in the deque twice if an edge of 0 has found a shorter path to it later
+		if (m_Settled[vertex] == m_Stamp)
+			continue;
+		m_Settled[vertex] = m_Stamp;
+		m_SettledVertices++;
+
+		unsigned long long distance = m_Distance[vertex];
+		if (!visit(vertex, distance))
+			return;
+
+		for (unsigned int e = G.GetEdgesBegin(vertex); e < G.GetEdgesEnd(vertex); ++e)
+		{
+			unsigned int target = G.GetEdgeTarget(e);
+			bool bZero = G.GetEdgeWeight(e) == 0.0;
+			unsigned long long newDistance = distance + (bZero ? 0 : 1);
+
+			if (m_Settled[target] != m_Stamp && (m_Reached[target] != m_Stamp || newDistance < m_Distance[target]))
+			{
+				m_Reached[target] = m_Stamp;
+				m_Distance[target] = newDistance;
+				if (bZero)
+					m_Deque.push_front(target);
+				else
+					m_Deque.push_back(target);
+			}
+		}
+	}
+}
+
+template<typename TVisit>
+void IntegerShortestPathAlgorithm::SearchBuckets(const CompactGraph &G, unsigned int u, TVisit visit)
+{
+	unsigned int bucketsAmount = G.GetMaxIntegerWeight() + 1;
+	//  Vertices in the buckets, the ones left there after a shorter path was found included
+	size_t queued = 1;
+	unsigned long long distance = 0;
+
+	if (m_Buckets.size() < bucketsAmount)
+		m_Buckets.resize(bucketsAmount);
+	for (unsigned int i = 0; i < bucketsAmount; ++i)
+		m_Buckets[i].clear();
+	m_Buckets[0].push_back(u);
+
+	for (; queued > 0; ++distance)
+	{
+		//  Edges of 0 add vertices to the current bucket while it is processed
+		vector<unsigned int> &bucket = m_Buckets[distance % bucketsAmount];
+		while (!bucket.empty())
+		{
+			unsigned int vertex = bucket.back();
+			bucket.pop_back();
+			queued--;
+
+			if (m_Settled[vertex] == m_Stamp || m_Distance[vertex] != distance)
+				continue;
+			m_Settled[vertex] = m_Stamp;
+			m_SettledVertices++;
+
+			if (!visit(vertex, distance))
+				return;
+
+			for (unsigned int e = G.GetEdgesBegin(vertex); e < G.GetEdgesEnd(vertex); ++e)
+			{
+				unsigned int target = G.GetEdgeTarget(e);
+				unsigned long long newDistance = distance + static_cast<unsigned int>(G.GetEdgeWeight(e));
+
+				if (m_Settled[target] != m_Stamp && (m_Reached[target] != m_Stamp || newDistance < m_Distance[target]))
+				{
+					m_Reached[target] = m_Stamp;
+					m_Distance[target] = newDistance;
+					m_Buckets[newDistance % bucketsAmount].push_back(target);
+					queued++;
+				}
+			}
+		}
+	}
+}
+
+double IntegerShortestPathAlgorithm::GetShortestPathLength(const CompactGraph &G, unsigned int u, unsigned int v)
+{
+	double length = -1.0;
+
+	Search(G, u, [&](unsigned int vertex, unsigned long long distance)
+	{
+		if (vertex != v)
+			return true;
+		length = static_cast<double>(distance);
+		return false;
+	});
+
+	return length;
+}
+
+//  Distances are summed as integers, so the order of the vertices doesn't change the sum
+double IntegerShortestPathAlgorithm::AverageShortestPath(const CompactGraph &G, unsigned int u)
+{
+	unsigned long long sum = 0;
+
+	Search(G, u, [&](unsigned int, unsigned long long distance)
+	{
+		sum += distance;
+		return true;
+	});
+
+	if (m_SettledVertices > 1)
+		return static_cast<double>(sum) / (m_SettledVertices - 1);
+	else
+		return -1.0;
+}
+
+vector<double> IntegerShortestPathAlgorithm::GetShortestDistances(const CompactGraph &G, unsigned int u)
+{
+	vector<double> distances(G.GetVerticesAmount(), -1.0);
+
+	Search(G, u, [&](unsigned int vertex, unsigned long long distance)
+	{
+		distances[vertex] = static_cast<double>(distance);
+		return true;
+	});
+
+	return distances;
+}
@@ -0,0 +1,59 @@
+///  Contains the shortest path algorithm for graphs with integer weights declaration
+
+#ifndef INTEGERSHORTESTPATH_H__
+#define INTEGERSHORTESTPATH_H__
+
+#include "CompactGraph.h"
+#include <deque>
+
+using std::deque;
+
+//  This class implements the Dijkstra algorithm for a CompactGraph whose weights are small non-negative integers.
+//  The close set is not a heap of doubles but a queue that is cheaper for integer distances:
+//  - all the weights are 0 or 1 (the Hex board): 0-1 BFS. A vertex reached by an edge of 0 goes to the front of a deque,
+//    by an edge of 1 to its back, so the deque is always sorted by distance
+//  - the weights are not more than MAX_BUCKET_WEIGHT: Dial's buckets. The bucket d % (maxWeight + 1) has the vertices
+//    with the distance d, the buckets are taken in a circle. Only maxWeight + 1 buckets are needed because a distance
+//    in the queue is never more than the current distance plus maxWeight
+//  ShortestPathAlgorithm uses this class for a CompactGraph automatically (see CanSearch), the results are the same
+class IntegerShortestPathAlgorithm
+{
+private:
+	vector<vector<unsigned int>> m_Buckets;
+	deque<unsigned int> m_Deque;
+	vector<unsigned long long> m_Distance;
+	//  Search stamps of the reached and the settled vertices, the same as the open set of ShortestPathAlgorithm
+	vector<unsigned int> m_Reached;
+	vector<unsigned int> m_Settled;
+	unsigned int m_Stamp;
+	unsigned int m_SettledVertices;
+
+	void Reset(unsigned int size);
+	//  Settle the vertices in the order of their distance from u and call visit(vertex, distance) for every one of them,
+	//  until it returns false
+	template<typename TVisit>
+	void Search(const CompactGraph &G, unsigned int u, TVisit visit);
+	template<typename TVisit>
+	void SearchZeroOne(const CompactGraph &G, unsigned int u, TVisit visit);
+	template<typename TVisit>
+	void SearchBuckets(const CompactGraph &G, unsigned int u, TVisit visit);
+public:
+	//  The biggest weight for the buckets. The buckets are scanned one by one, so big weights would make the search slow
+	static const unsigned int MAX_BUCKET_WEIGHT = 1 << 12;
+
+	IntegerShortestPathAlgorithm();
+	~IntegerShortestPathAlgorithm();
+
+	//  Check if the weights of the graph are integers this class can search with
+	static bool CanSearch(const CompactGraph &G) { return G.HasIntegerWeights() && G.GetMaxIntegerWeight() <= MAX_BUCKET_WEIGHT; }
+
+	//  The same as the methods of ShortestPathAlgorithm. A path from u to itself has the length 0 here,
+	//  GetShortestPathLength of ShortestPathAlgorithm looks for the edge from u to u itself
+	double GetShortestPathLength(const CompactGraph &G, unsigned int u, unsigned int v);
+	double AverageShortestPath(const CompactGraph &G, unsigned int u);
+	vector<double> GetShortestDistances(const CompactGraph &G, unsigned int u);
+	//  The number of the vertices settled by the last search
+	unsigned int GetSettledVertices() const { return m_SettledVertices; }
+};
+
+#endif
@@ -0,0 +1,107 @@
+///  Contains the read-only memory-mapped file implementation
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : m_pData(nullptr), m_Size(0), m_File(INVALID_HANDLE_VALUE), m_Mapping(nullptr)
+{
+}
+#else
+MappedFile::MappedFile() : m_pData(nullptr), m_Size(0), m_File(-1)
+{
+}
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const string &filename)
+{
+	LARGE_INTEGER size;
+
+	Close();
+	m_File = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_File == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_File, &size) || size.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_Mapping != nullptr)
+		m_pData = static_cast<const char *>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_pData == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	m_Size = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_pData != nullptr)
+		UnmapViewOfFile(m_pData);
+	if (m_Mapping != nullptr)
+		CloseHandle(m_Mapping);
+	if (m_File != INVALID_HANDLE_VALUE)
+		CloseHandle(m_File);
+
+	m_pData = nullptr;
+	m_Size = 0;
+	m_Mapping = nullptr;
+	m_File = INVALID_HANDLE_VALUE;
+}
+#else
+bool MappedFile::Open(const string &filename)
+{
+	struct stat status;
+
+	Close();
+	m_File = open(filename.c_str(), O_RDONLY);
+	//  A file of 0 bytes can't be mapped
+	if (m_File < 0 || fstat(m_File, &status) != 0 || status.st_size == 0)
+	{
+		Close();
+		return false;
+	}
+
+	void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, m_File, 0);
+	if (data == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+
+	m_pData = static_cast<const char *>(data);
+	m_Size = static_cast<size_t>(status.st_size);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_pData != nullptr)
+		munmap(const_cast<char *>(m_pData), m_Size);
+	if (m_File >= 0)
+		close(m_File);
+
+	m_pData = nullptr;
+	m_Size = 0;
+	m_File = -1;
+}
+#endif
@@ -0,0 +1,39 @@
+///  Contains the read-only memory-mapped file declaration
+
+#ifndef MAPPEDFILE_H__
+#define MAPPEDFILE_H__
+
+#include <string>
+
+using std::string;
+
+//  This class maps a whole file into memory for reading. The pages are read by the system when they are touched
+//  and are shared with every other process that maps the same file, nothing is copied to the heap.
+//  It uses mmap on POSIX systems and MapViewOfFile on Windows
+class MappedFile
+{
+private:
+	const char *m_pData;
+	size_t m_Size;
+#ifdef _WIN32
+	void *m_File;
+	void *m_Mapping;
+#else
+	int m_File;
+#endif
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	//  Map the file, false if it can't be opened or mapped. A mapped file is closed first
+	bool Open(const string &filename);
+	void Close();
+
+	bool IsOpen() const { return m_pData != nullptr; }
+	const char *GetData() const { return m_pData; }
+	size_t GetSize() const { return m_Size; }
+};
+
+#endif
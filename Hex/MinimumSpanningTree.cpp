@@ -0,0 +1,361 @@
+///  Contains the minimum spanning tree algorithms implementation
+#include "MinimumSpanningTree.h"
+#include "DisjointSet.h"
+#include "ConcurrentDisjointSet.h"
+#include "Barrier.h"
+#include "Threads.h"
+#include <algorithm>
+
+//  Call function(target, weight, color) for every edge of the vertex v
+template<typename TFunction>
+static void ForEachColoredEdge(const Graph &G, unsigned int v, TFunction function)
+{
+	const list<Edge> &edges = G.GetNodeEdges(v);
+	for (auto it = edges.begin(); it != edges.end(); ++it)
+		function(it->GetEndVertexNumber(), it->GetEdgeWeight(), it->GetEdgeColor());
+}
+
+template<typename TFunction>
+static void ForEachColoredEdge(const CompactGraph &G, unsigned int v, TFunction function)
+{
+	for (unsigned int e = G.GetEdgesBegin(v); e < G.GetEdgesEnd(v); ++e)
+		function(G.GetEdgeTarget(e), G.GetEdgeWeight(e), G.GetEdgeColor(e));
+}
+
+MinimumSpanningTreeAlgorithm::MinimumSpanningTreeAlgorithm(unsigned int threads /* = 0 */) : m_Threads(0), m_Rounds(0)
+{
+	SetThreads(threads);
+}
+
+MinimumSpanningTreeAlgorithm::~MinimumSpanningTreeAlgorithm()
+{
+}
+
+void MinimumSpanningTreeAlgorithm::SetThreads(unsigned int threads)
+{
+	m_Threads = GetThreadCount(threads);
+}
+
+template<typename TGraph>
+Graph MinimumSpanningTreeAlgorithm::Prim(const TGraph &G, double &length)
+{
+	unsigned int size = G.GetVerticesAmount();
+	unsigned int treeSize = 0;
+	vector<unsigned int> sources, targets;
+	vector<double> weights;
+	vector<PlayerColor> colors;
+
+	length = 0;
+	if (size == 0)
+		return Graph(0);
+
+	m_Queue.Reset(size);
+	m_InTree.assign(size, false);
+	m_Parent.resize(size);
+	m_ParentColor.resize(size);
+
+	//  Start with a single vertex
+	m_Queue.Insert(0, 0.0);
+	while (!m_Queue.Empty())
+	{
+		unsigned int v = m_Queue.Top();
+		double weight = m_Queue.GetTopPriority();
+		m_Queue.Pop();
+
+		//  Add the vertex to the tree and decrease the edges to its neighbors out of the tree
+		m_InTree[v] = true;
+		treeSize++;
+		if (v != 0)
+		{
+			sources.push_back(m_Parent[v]);
+			targets.push_back(v);
+			weights.push_back(weight);
+			colors.push_back(m_ParentColor[v]);
+			length += weight;
+		}
+
+		ForEachColoredEdge(G, v, [&](unsigned int target, double edgeWeight, PlayerColor color)
+		{
+			if (!m_InTree[target] && m_Queue.InsertIfPriorityLess(target, edgeWeight))
+			{
+				m_Parent[target] = v;
+				m_ParentColor[target] = color;
+			}
+		});
+	}
+
+	if (treeSize != size || size == 1)
+	{
+		length = DBL_MAX;
+		return Graph(0);
+	}
+	return Graph(size, sources, targets, weights, colors);
+}
+
+template<typename TGraph>
+Graph MinimumSpanningTreeAlgorithm::Kruskal(const TGraph &G, double &length)
+{
+	unsigned int size = G.GetVerticesAmount();
+	vector<unsigned int> sources, targets;
+	vector<double> weights;
+	vector<PlayerColor> colors;
+
+	length = 0;
+	if (size == 0)
+		return Graph(0);
+
+	//  Loops never join two trees
+	m_Edges.clear();
+	for (unsigned int v = 0; v < size; ++v)
+		ForEachColoredEdge(G, v, [&](unsigned int target, double weight, PlayerColor color)
+		{
+			if (target != v)
+			{
+				WeightedEdge edge = { weight, v, target, color };
+				m_Edges.push_back(edge);
+			}
+		});
+
+	//  Edges of the same length are taken in the order of their vertices, so the tree doesn't depend on the sort.
+	//  Not all the edges are sorted: the lightest ones are selected in O(E) and sorted, and the next ones are selected
+	//  only if the tree isn't complete yet. On a dense graph the tree is made of a small part of the edges
+	auto lighter = [](const WeightedEdge &e1, const WeightedEdge &e2)
+	{
+		if (e1.m_Weight != e2.m_Weight)
+			return e1.m_Weight < e2.m_Weight;
+		if (e1.m_Source != e2.m_Source)
+			return e1.m_Source < e2.m_Source;
+		return e1.m_Target < e2.m_Target;
+	};
+
+	DisjointSet forest(size);
+	size_t chunk = 2 * static_cast<size_t>(size);
+	for (auto first = m_Edges.begin(); first != m_Edges.end() && sources.size() + 1 < size; chunk *= 2)
+	{
+		auto last = static_cast<size_t>(m_Edges.end() - first) > chunk ? first + chunk : m_Edges.end();
+		std::nth_element(first, last - 1, m_Edges.end(), lighter);
+		std::sort(first, last, lighter);
+
+		for (; first != last && sources.size() + 1 < size; ++first)
+			if (forest.Union(first->m_Source, first->m_Target))
+			{
+				sources.push_back(first->m_Source);
+				targets.push_back(first->m_Target);
+				weights.push_back(first->m_Weight);
+				colors.push_back(first->m_Color);
+				length += first->m_Weight;
+			}
+	}
+
+	if (sources.size() + 1 != size || size == 1)
+	{
+		length = DBL_MAX;
+		return Graph(0);
+	}
+	return Graph(size, sources, targets, weights, colors);
+}
+
+template<typename TGraph>
+Graph MinimumSpanningTreeAlgorithm::Boruvka(const TGraph &G, double &length)
+{
+	//  The vertices are taken by the threads in blocks
+	const unsigned int block = 256;
+	const unsigned int NO_VERTEX = UINT_MAX;
+	unsigned int size = G.GetVerticesAmount();
+	unsigned int threads = std::max(1u, std::min(m_Threads, size));
+	vector<unsigned int> sources, targets;
+	vector<double> weights;
+	vector<PlayerColor> colors;
+
+	length = 0;
+	m_Rounds = 0;
+	m_Components.clear();
+	m_ComponentLengths.clear();
+	if (size == 0)
+		return Graph(0);
+
+	//  Edges are compared as undirected ones, by the length and then by the smaller and the bigger vertex, so both
+	//  components of an edge see it the same way and the chosen edges can't make a cycle
+	auto lighter = [](const WeightedEdge &e1, const WeightedEdge &e2)
+	{
+		if (e1.m_Weight != e2.m_Weight)
+			return e1.m_Weight < e2.m_Weight;
+		unsigned int min1 = std::min(e1.m_Source, e1.m_Target), min2 = std::min(e2.m_Source, e2.m_Target);
+		if (min1 != min2)
+			return min1 < min2;
+		return std::max(e1.m_Source, e1.m_Target) < std::max(e2.m_Source, e2.m_Target);
+	};
+
+	ConcurrentDisjointSet forest(size);
+	//  The component of every vertex at the start of the round, it is the smallest vertex of the component
+	vector<unsigned int> component(size);
+	//  The vertex with the lightest edge out of the component, by the component
+	vector<atomic<unsigned int>> best(size);
+	//  The lightest edge out of the component of every vertex
+	vector<WeightedEdge> candidate(size);
+	//  Vertices that had an edge out of their component in the last round. Components only grow, so a vertex
+	//  without such an edge has all its neighbors in its component from now on
+	vector<unsigned int> active(size);
+	vector<vector<unsigned int>> nextActive(threads);
+	vector<vector<WeightedEdge>> treeEdges(threads);
+	atomic<unsigned int> nextScan(0), nextVertex(0);
+	Barrier barrier(threads);
+
+	for (unsigned int v = 0; v < size; ++v)
+	{
+		component[v] = v;
+		best[v].store(NO_VERTEX, std::memory_order_relaxed);
+		active[v] = v;
+	}
+
+	auto worker = [&](unsigned int t)
+	{
+		vector<unsigned int> &local = nextActive[t];
+		unsigned int activeAmount = size;
+
+		while (true)
+		{
+			//  Find the lightest edge out of the component of every active vertex and offer it to the component.
+			//  The edge of a vertex is written before the vertex is published in best, and isn't changed in the round
+			local.clear();
+			for (unsigned int first = nextScan.fetch_add(block); first < activeAmount; first = nextScan.fetch_add(block))
+				for (unsigned int i = first; i < first + block && i < activeAmount; ++i)
+				{
+					unsigned int v = active[i], c = component[v];
+					WeightedEdge &edge = candidate[v];
+					edge.m_Target = NO_VERTEX;
+
+					ForEachColoredEdge(G, v, [&](unsigned int target, double weight, PlayerColor color)
+					{
+						if (component[target] == c || (edge.m_Target != NO_VERTEX && weight > edge.m_Weight))
+							return;
+						WeightedEdge e = { weight, v, target, color };
+						if (edge.m_Target == NO_VERTEX || lighter(e, edge))
+							edge = e;
+					});
+					if (edge.m_Target == NO_VERTEX)
+						continue;
+
+					local.push_back(v);
+					unsigned int current = best[c].load(std::memory_order_acquire);
+					while ((current == NO_VERTEX || lighter(edge, candidate[current])) &&
+						!best[c].compare_exchange_weak(current, v, std::memory_order_acq_rel, std::memory_order_acquire))
+					{
+					}
+				}
+			barrier.Wait();
+
+			//  Every thread counts the active vertices of the next round and the place of its own ones.
+			//  No component has an edge out of it when there are none, then the forest is complete
+			size_t offset = 0;
+			activeAmount = 0;
+			for (unsigned int i = 0; i < threads; ++i)
+			{
+				if (i < t)
+					offset += nextActive[i].size();
+				activeAmount += static_cast<unsigned int>(nextActive[i].size());
+			}
+			if (activeAmount == 0)
+				break;
+			if (t == 0)
+			{
+				m_Rounds++;
+				nextScan.store(0);
+			}
+
+			//  Join the components by their chosen edges. An edge chosen by both its components is added by the one
+			//  of its smaller vertex
+			for (auto it = local.begin(); it != local.end(); ++it)
+			{
+				unsigned int v = *it;
+				if (best[component[v]].load(std::memory_order_relaxed) != v)
+					continue;
+
+				const WeightedEdge &edge = candidate[v];
+				unsigned int other = best[component[edge.m_Target]].load(std::memory_order_relaxed);
+				if (other == edge.m_Target && candidate[other].m_Target == v && v > other)
+					continue;
+				if (forest.Union(v, edge.m_Target))
+					treeEdges[t].push_back(edge);
+			}
+			std::copy(local.begin(), local.end(), active.begin() + offset);
+			barrier.Wait();
+
+			//  Components of the next round
+			for (unsigned int first = nextVertex.fetch_add(block); first < size; first = nextVertex.fetch_add(block))
+				for (unsigned int v = first; v < first + block && v < size; ++v)
+				{
+					component[v] = forest.Find(v);
+					best[v].store(NO_VERTEX, std::memory_order_relaxed);
+				}
+			barrier.Wait();
+
+			if (t == 0)
+				nextVertex.store(0);
+		}
+	};
+
+	RunThreads(threads, worker);
+
+	//  The representative of a component is its smallest vertex, so it is numbered before the other vertices
+	m_Components.resize(size);
+	for (unsigned int v = 0; v < size; ++v)
+		if (component[v] == v)
+		{
+			m_Components[v] = static_cast<unsigned int>(m_ComponentLengths.size());
+			m_ComponentLengths.push_back(0.0);
+		}
+		else
+			m_Components[v] = m_Components[component[v]];
+
+	//  The edges in the order of Kruskal's algorithm, the lengths don't depend on the threads that found them
+	m_Edges.clear();
+	for (auto it = treeEdges.begin(); it != treeEdges.end(); ++it)
+		m_Edges.insert(m_Edges.end(), it->begin(), it->end());
+	std::sort(m_Edges.begin(), m_Edges.end(), lighter);
+
+	sources.reserve(m_Edges.size());
+	targets.reserve(m_Edges.size());
+	weights.reserve(m_Edges.size());
+	colors.reserve(m_Edges.size());
+	for (auto it = m_Edges.begin(); it != m_Edges.end(); ++it)
+	{
+		sources.push_back(it->m_Source);
+		targets.push_back(it->m_Target);
+		weights.push_back(it->m_Weight);
+		colors.push_back(it->m_Color);
+		m_ComponentLengths[m_Components[it->m_Source]] += it->m_Weight;
+		length += it->m_Weight;
+	}
+	return Graph(size, sources, targets, weights, colors);
+}
+
+Graph MinimumSpanningTreeAlgorithm::PrimMST(const Graph &G, double &length)
+{
+	return Prim(G, length);
+}
+
+Graph MinimumSpanningTreeAlgorithm::PrimMST(const CompactGraph &G, double &length)
+{
+	return Prim(G, length);
+}
+
+Graph MinimumSpanningTreeAlgorithm::KruskalMST(const Graph &G, double &length)
+{
+	return Kruskal(G, length);
+}
+
+Graph MinimumSpanningTreeAlgorithm::KruskalMST(const CompactGraph &G, double &length)
+{
+	return Kruskal(G, length);
+}
+
+Graph MinimumSpanningTreeAlgorithm::BoruvkaMSF(const Graph &G, double &length)
+{
+	return Boruvka(G, length);
+}
+
+Graph MinimumSpanningTreeAlgorithm::BoruvkaMSF(const CompactGraph &G, double &length)
+{
+	return Boruvka(G, length);
+}
@@ -0,0 +1,84 @@
+///  Contains the minimum spanning tree algorithms declaration
+
+#ifndef MINIMUMSPANNINGTREE_H__
+#define MINIMUMSPANNINGTREE_H__
+
+#include "CompactGraph.h"
+
+//  This class finds the minimum spanning tree of a graph. It returns the tree as a Graph with an edge from a vertex
+//  of the tree to every other vertex, and the length of the tree. A disconnected graph has no spanning tree, then
+//  the tree has 0 vertices and the length is DBL_MAX. A graph of a single vertex gives the same result, as Graph::PrimMST
+//  has always returned for it.
+//  - Prim's algorithm grows the tree from the vertex 0. Every vertex out of the tree is in an indexed heap once with
+//    the length of its lightest edge from the tree, the edge is decreased when a lighter one is found, and the vertices
+//    of the tree are marked in an array, so it runs in O(E log V). It follows the edges from the tree, as Graph::PrimMST
+//  - Kruskal's algorithm takes the edges from the lightest one and keeps the ones that join two trees of a disjoint set
+//    forest, O(E log E). It sorts only the lightest edges while the tree is not complete, so on a dense graph most of
+//    the edges are never sorted. It doesn't look at the direction of the edges, so it is for undirected graphs,
+//    where every edge has the reverse one
+//  Both give the same length on an undirected graph, up to the rounding of the sum of the lengths in a different order.
+//  - Boruvka's algorithm runs on many threads and doesn't need a connected graph: it finds the minimum spanning forest,
+//    a tree for every connected component. In every round each vertex finds its lightest edge out of its component,
+//    the lightest one of the component is chosen with a compare-and-swap, and the chosen edges join the components in
+//    a concurrent disjoint set forest. Every round at least halves the number of the components that can be joined,
+//    so there are at most log(V) rounds of O(E) work. A vertex that has no edge out of its component is not visited
+//    any more. Edges of the same length are compared by their vertices, so the forest doesn't depend on the threads.
+//    It is for undirected graphs as Kruskal's algorithm, and its edges are summed in the same order, so the length
+//    of a connected graph is exactly the one Kruskal's algorithm gives
+class MinimumSpanningTreeAlgorithm
+{
+private:
+	//  An edge of the graph for Kruskal's algorithm
+	struct WeightedEdge
+	{
+		double m_Weight;
+		unsigned int m_Source;
+		unsigned int m_Target;
+		PlayerColor m_Color;
+	};
+
+	unsigned int m_Threads;
+	//  The number of the rounds of the last Boruvka's forest
+	unsigned int m_Rounds;
+	//  The component of every vertex in the last Boruvka's forest and the length of every component tree
+	vector<unsigned int> m_Components;
+	vector<double> m_ComponentLengths;
+	IndexedPriorityQueue<double> m_Queue;
+	vector<bool> m_InTree;
+	//  The edge from the tree to the vertex out of it that has its priority in the queue
+	vector<unsigned int> m_Parent;
+	vector<PlayerColor> m_ParentColor;
+	vector<WeightedEdge> m_Edges;
+
+	template<typename TGraph>
+	Graph Prim(const TGraph &G, double &length);
+	template<typename TGraph>
+	Graph Kruskal(const TGraph &G, double &length);
+	template<typename TGraph>
+	Graph Boruvka(const TGraph &G, double &length);
+public:
+	//  threads == 0 means one thread per hardware core, only Boruvka's algorithm uses more than one
+	explicit MinimumSpanningTreeAlgorithm(unsigned int threads = 0);
+	~MinimumSpanningTreeAlgorithm();
+
+	Graph PrimMST(const Graph &G, double &length);
+	Graph PrimMST(const CompactGraph &G, double &length);
+	Graph KruskalMST(const Graph &G, double &length);
+	Graph KruskalMST(const CompactGraph &G, double &length);
+	//  Get the minimum spanning forest: the graph with all the vertices of G and the edges of the tree of every
+	//  connected component, and the total length of the trees. A graph without edges gives the forest of single
+	//  vertices and the length 0. GetComponents and GetComponentLengths tell the trees apart
+	Graph BoruvkaMSF(const Graph &G, double &length);
+	Graph BoruvkaMSF(const CompactGraph &G, double &length);
+
+	unsigned int GetThreads() const { return m_Threads; }
+	void SetThreads(unsigned int threads);
+	//  The component of every vertex of the last forest. Components are numbered from 0 in the order of their first vertex
+	const vector<unsigned int> &GetComponents() const { return m_Components; }
+	//  The length of the tree of every component of the last forest, 0 for a single vertex
+	const vector<double> &GetComponentLengths() const { return m_ComponentLengths; }
+	//  The number of the rounds that joined components in the last forest
+	unsigned int GetRounds() const { return m_Rounds; }
+};
+
+#endif
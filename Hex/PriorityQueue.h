@@ -4,12 +4,14 @@
 #define PRIORITY_QUEUE_H__
 
 #include <algorithm>
+#include <climits>
 #include <vector>
 
 //  Functions to implement min heap
 using std::vector;
 using std::pop_heap;
 using std::push_heap;
+using std::make_heap;
 
 //  Template class implementing priority queue element.
 //  First template parameter is value type (unsigned int as the number of vertex in the Dijkstra algo)
@@ -127,6 +129,8 @@ void PriorityQueue<TVal, TPriority>::ChangePriority(const TVal &value, const TPr
 		if (it->GetValue() == value)
 		{
 			it->SetPriority(priority);
+			//  The element may have to move up or down, so the heap is rebuilt. It is O(n) like the search above
+			make_heap(m_MinHeap.begin(), m_MinHeap.end(), Compare<TVal, TPriority>);
 			return;
 		}
 }
@@ -154,4 +158,171 @@ void PriorityQueue<TVal, TPriority>::InsertIfPriorityLess(const TVal &val, const
 		Insert(val, priority);
 }
 
+//  Template class implementing priority queue of the values 0..size-1 (vertex numbers in the Dijkstra algo).
+//  Besides the heap it keeps the position of every value in the heap, so a check if the value is in the queue
+//  is O(1) and a priority change is O(log n). Every value is in the queue at most once
+template<typename TPriority>
+class IndexedPriorityQueue
+{
+private:
+	static const unsigned int NOT_IN_QUEUE = UINT_MAX;
+
+	vector<PriorityQueueElement<unsigned int, TPriority>> m_MinHeap;
+	//  Position of every value in m_MinHeap, NOT_IN_QUEUE if the value is not in the queue
+	vector<unsigned int> m_Position;
+
+	void Swap(size_t pos1, size_t pos2);
+	void SiftUp(size_t pos);
+	void SiftDown(size_t pos);
+public:
+	explicit IndexedPriorityQueue(unsigned int size = 0) : m_Position(size, NOT_IN_QUEUE) { }
+	~IndexedPriorityQueue() { }
+
+	//  Remove all the elements and allow the values 0..size-1. If the size is the same only the elements
+	//  left in the queue are reset, so a queue can be reused for many searches on a big graph
+	void Reset(unsigned int size);
+
+	//  Checks if the element is in the queue
+	bool Contains(unsigned int val) const { return val < m_Position.size() && m_Position[val] != NOT_IN_QUEUE; }
+	//  Gets the priority of the element if the queue contains it and returns true. Returns false otherwise
+	bool GetPriorityIfContains(unsigned int val, TPriority &priority) const;
+	//  Retrieves the element on the top of the queue
+	unsigned int Top() const { return m_MinHeap.front().GetValue(); }
+	//  Get the priority of the top element
+	TPriority GetTopPriority() const { return m_MinHeap.front().GetPriority(); }
+	//  Returns the size of the queue
+	size_t Size() const { return m_MinHeap.size(); }
+	//  Checks if the queue is empty
+	bool Empty() const { return m_MinHeap.size() == 0; }
+
+	//  Changes priority of an element in the queue to the given
+	void ChangePriority(unsigned int val, const TPriority &priority);
+	//  Deletes element on the top from the queue
+	void Pop();
+	//  Inserts the element to the queue. If it is already there its priority is changed
+	void Insert(unsigned int val, const TPriority &priority);
+	//  Inserts the element if it is not in the queue or decreases its priority if the given one is less.
+	//  Returns true if the queue has changed
+	bool InsertIfPriorityLess(unsigned int val, const TPriority &priority);
+};
+
+template<typename TPriority>
+const unsigned int IndexedPriorityQueue<TPriority>::NOT_IN_QUEUE;
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::Swap(size_t pos1, size_t pos2)
+{
+	std::swap(m_MinHeap[pos1], m_MinHeap[pos2]);
+	m_Position[m_MinHeap[pos1].GetValue()] = pos1;
+	m_Position[m_MinHeap[pos2].GetValue()] = pos2;
+}
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::SiftUp(size_t pos)
+{
+	while (pos > 0 && m_MinHeap[pos].GetPriority() < m_MinHeap[(pos - 1) / 2].GetPriority())
+	{
+		Swap(pos, (pos - 1) / 2);
+		pos = (pos - 1) / 2;
+	}
+}
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::SiftDown(size_t pos)
+{
+	for (;;)
+	{
+		size_t smallest = pos, left = 2 * pos + 1, right = 2 * pos + 2;
+
+		if (left < m_MinHeap.size() && m_MinHeap[left].GetPriority() < m_MinHeap[smallest].GetPriority())
+			smallest = left;
+		if (right < m_MinHeap.size() && m_MinHeap[right].GetPriority() < m_MinHeap[smallest].GetPriority())
+			smallest = right;
+		if (smallest == pos)
+			return;
+
+		Swap(pos, smallest);
+		pos = smallest;
+	}
+}
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::Reset(unsigned int size)
+{
+	if (m_Position.size() != size)
+		m_Position.assign(size, NOT_IN_QUEUE);
+	else
+		for (auto it = m_MinHeap.begin(); it != m_MinHeap.end(); ++it)
+			m_Position[it->GetValue()] = NOT_IN_QUEUE;
+
+	m_MinHeap.clear();
+}
+
+template<typename TPriority>
+bool IndexedPriorityQueue<TPriority>::GetPriorityIfContains(unsigned int val, TPriority &priority) const
+{
+	if (!Contains(val))
+		return false;
+
+	priority = m_MinHeap[m_Position[val]].GetPriority();
+	return true;
+}
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::ChangePriority(unsigned int val, const TPriority &priority)
+{
+	if (!Contains(val))
+		return;
+
+	size_t pos = m_Position[val];
+	m_MinHeap[pos].SetPriority(priority);
+	SiftUp(pos);
+	SiftDown(m_Position[val]);
+}
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::Pop()
+{
+	Swap(0, m_MinHeap.size() - 1);
+	m_Position[m_MinHeap.back().GetValue()] = NOT_IN_QUEUE;
+	m_MinHeap.pop_back();
+	if (!m_MinHeap.empty())
+		SiftDown(0);
+}
+
+template<typename TPriority>
+void IndexedPriorityQueue<TPriority>::Insert(unsigned int val, const TPriority &priority)
+{
+	if (Contains(val))
+	{
+		ChangePriority(val, priority);
+		return;
+	}
+
+	if (val >= m_Position.size())
+		m_Position.resize(val + 1, NOT_IN_QUEUE);
+	m_Position[val] = m_MinHeap.size();
+	m_MinHeap.push_back(PriorityQueueElement<unsigned int, TPriority>(val, priority));
+	SiftUp(m_MinHeap.size() - 1);
+}
+
+template<typename TPriority>
+bool IndexedPriorityQueue<TPriority>::InsertIfPriorityLess(unsigned int val, const TPriority &priority)
+{
+	TPriority tmp_priority;
+	if (!GetPriorityIfContains(val, tmp_priority))
+		Insert(val, priority);
+	else if (priority < tmp_priority)
+	{
+		//  Decrease-key: the element can only move up
+		size_t pos = m_Position[val];
+		m_MinHeap[pos].SetPriority(priority);
+		SiftUp(pos);
+	}
+	else
+		return false;
+
+	return true;
+}
+
 #endif
\ No newline at end of file
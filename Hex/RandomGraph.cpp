@@ -0,0 +1,146 @@
+///  Contains the parallel random graph generator implementation
+#include "RandomGraph.h"
+#include "Threads.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+//  Rows of the vertices generated by a block, every block has its own random stream
+static const unsigned int BLOCK_ROWS = 256;
+
+//  The SplitMix64 mix of the seed and the number of the block, neighbor blocks get unrelated seeds
+static unsigned long long GetBlockSeed(unsigned long long seed, unsigned long long block)
+{
+	unsigned long long z = seed + (block + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+//  Doubles are made of the 53 bits of the generator instead of a standard distribution,
+//  whose results differ between the libraries
+static inline double GetRandomDouble(std::mt19937_64 &random)
+{
+	return (random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+RandomGraphGenerator::RandomGraphGenerator(unsigned long long seed, unsigned int threads /* = 0 */) : m_Seed(seed), m_Threads(0)
+{
+	SetThreads(threads);
+}
+
+RandomGraphGenerator::~RandomGraphGenerator()
+{
+}
+
+void RandomGraphGenerator::SetThreads(unsigned int threads)
+{
+	m_Threads = GetThreadCount(threads);
+}
+
+void RandomGraphGenerator::GenerateEdges(unsigned int size, double density, double distanceMin, double distanceMax,
+	vector<unsigned int> &sources, vector<unsigned int> &targets, vector<double> &weights) const
+{
+	//  Edges of the rows of a block, in the order the rows are generated
+	struct Block
+	{
+		vector<unsigned int> m_Sources;
+		vector<unsigned int> m_Targets;
+		vector<double> m_Weights;
+	};
+
+	unsigned int blocksAmount = (size + BLOCK_ROWS - 1) / BLOCK_ROWS;
+	vector<Block> blocks(blocksAmount);
+	atomic<unsigned int> next(0);
+	//  log(1 - p) of the geometric distribution, density 1 has every pair and no skips. log1p keeps a density
+	//  below the precision of 1 - p from rounding to a logarithm of 0, only the density 0 has no edges
+	double logMiss = density < 1.0 ? log1p(-density) : 0.0;
+	bool noEdges = density <= 0.0 || (density < 1.0 && logMiss == 0.0);
+
+	auto worker = [&](unsigned int)
+	{
+		for (unsigned int b = next.fetch_add(1); b < blocksAmount; b = next.fetch_add(1))
+		{
+			Block &block = blocks[b];
+			std::mt19937_64 random(GetBlockSeed(m_Seed, b));
+			unsigned int last = static_cast<unsigned int>(std::min<unsigned long long>(size, (b + 1ULL) * BLOCK_ROWS));
+
+			for (unsigned int i = b * BLOCK_ROWS; i < last; ++i)
+			{
+				//  a path to itself always exists
+				block.m_Sources.push_back(i);
+				block.m_Targets.push_back(i);
+				block.m_Weights.push_back(0.0);
+				if (noEdges)
+					continue;
+
+				//  j is the next pair (i, j) that has an edge. 1 - GetRandomDouble is never 0, so the logarithm is finite.
+				//  The skip of a tiny density can be too big for an integer, so it is compared with the pairs left first
+				for (unsigned int j = i; ; )
+				{
+					if (density < 1.0)
+					{
+						double skip = floor(log1p(-GetRandomDouble(random)) / logMiss);
+						if (!(skip < size - j - 1.0))
+							break;
+						j += static_cast<unsigned int>(skip) + 1;
+					}
+					else if (++j >= size)
+						break;
+
+					double distance = distanceMin + GetRandomDouble(random) * (distanceMax - distanceMin);
+					//  graph is undirected so we can go from i to j and from j to i
+					block.m_Sources.push_back(i);
+					block.m_Targets.push_back(j);
+					block.m_Weights.push_back(distance);
+					block.m_Sources.push_back(j);
+					block.m_Targets.push_back(i);
+					block.m_Weights.push_back(distance);
+				}
+			}
+		}
+	};
+
+	unsigned int threads = std::max(1u, std::min(m_Threads, blocksAmount));
+	RunThreads(threads, worker);
+
+	size_t edgesAmount = 0;
+	for (auto it = blocks.begin(); it != blocks.end(); ++it)
+		edgesAmount += it->m_Sources.size();
+
+	sources.clear();
+	targets.clear();
+	weights.clear();
+	sources.reserve(edgesAmount);
+	targets.reserve(edgesAmount);
+	weights.reserve(edgesAmount);
+	for (auto it = blocks.begin(); it != blocks.end(); ++it)
+	{
+		sources.insert(sources.end(), it->m_Sources.begin(), it->m_Sources.end());
+		targets.insert(targets.end(), it->m_Targets.begin(), it->m_Targets.end());
+		weights.insert(weights.end(), it->m_Weights.begin(), it->m_Weights.end());
+		vector<unsigned int>().swap(it->m_Sources);
+		vector<unsigned int>().swap(it->m_Targets);
+		vector<double>().swap(it->m_Weights);
+	}
+}
+
+//  The rows are generated in order, so the edges of a vertex to the vertices before it come first and the stable
+//  sort of the edges by their start vertex in the graph constructors gives the order of the adjacency lists
+Graph RandomGraphGenerator::GenerateGraph(unsigned int size, double density, double distanceMin, double distanceMax) const
+{
+	vector<unsigned int> sources, targets;
+	vector<double> weights;
+
+	GenerateEdges(size, density, distanceMin, distanceMax, sources, targets, weights);
+	return Graph(size, sources, targets, weights);
+}
+
+CompactGraph RandomGraphGenerator::GenerateCompactGraph(unsigned int size, double density, double distanceMin, double distanceMax) const
+{
+	vector<unsigned int> sources, targets;
+	vector<double> weights;
+
+	GenerateEdges(size, density, distanceMin, distanceMax, sources, targets, weights);
+	return CompactGraph(size, sources, targets, weights);
+}
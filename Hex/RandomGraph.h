@@ -0,0 +1,39 @@
+///  Contains the parallel random graph generator declaration
+
+#ifndef RANDOMGRAPH_H__
+#define RANDOMGRAPH_H__
+
+#include "CompactGraph.h"
+
+//  This class generates the undirected random graph G(n, p) of Erdos and Renyi: every pair of the vertices has an edge
+//  with the probability p (the density), the edge length is uniform between the minimum and the maximum distance.
+//  Every vertex also has an edge of 0 to itself, as Graph(size, density, ...) has always had.
+//  Pairs are not tried one by one: the number of the pairs skipped before the next edge has the geometric distribution,
+//  so it is taken from a single random number and the work is proportional to the number of the edges, not to size^2.
+//  The vertices are split into blocks of rows that are generated on many threads. Every block has its own random
+//  stream seeded by the seed and the number of the block, so the graph depends only on the seed, not on the threads
+class RandomGraphGenerator
+{
+private:
+	unsigned long long m_Seed;
+	unsigned int m_Threads;
+
+	//  Generate the directed edges of the graph in the order of the adjacency lists: an edge from the vertex v goes
+	//  after the edges from v to the vertices before v, then the edge from v to itself, then the edges to the vertices after v
+	void GenerateEdges(unsigned int size, double density, double distanceMin, double distanceMax,
+		vector<unsigned int> &sources, vector<unsigned int> &targets, vector<double> &weights) const;
+public:
+	//  threads == 0 means one thread per hardware core
+	explicit RandomGraphGenerator(unsigned long long seed, unsigned int threads = 0);
+	~RandomGraphGenerator();
+
+	Graph GenerateGraph(unsigned int size, double density, double distanceMin, double distanceMax) const;
+	CompactGraph GenerateCompactGraph(unsigned int size, double density, double distanceMin, double distanceMax) const;
+
+	unsigned long long GetSeed() const { return m_Seed; }
+	void SetSeed(unsigned long long seed) { m_Seed = seed; }
+	unsigned int GetThreads() const { return m_Threads; }
+	void SetThreads(unsigned int threads);
+};
+
+#endif
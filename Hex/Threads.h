@@ -0,0 +1,32 @@
+///  Contains the helpers that start the threads of the parallel algorithms
+
+#ifndef THREADS_H__
+#define THREADS_H__
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using std::thread;
+using std::vector;
+
+//  The number of threads given to a parallel algorithm, 0 is the number of the hardware threads
+inline unsigned int GetThreadCount(unsigned int threads)
+{
+	return threads > 0 ? threads : std::max(1u, thread::hardware_concurrency());
+}
+
+//  Run f(t) for t from 0 to count - 1 on count threads, the calling thread runs f(0)
+template<typename TFunction>
+void RunThreads(unsigned int count, TFunction f)
+{
+	vector<thread> workers;
+
+	for (unsigned int t = 1; t < count; ++t)
+		workers.push_back(thread(f, t));
+	f(0);
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		it->join();
+}
+
+#endif
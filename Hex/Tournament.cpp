@@ -0,0 +1,202 @@
+///  Contains the headless tournament runner implementation
+#include "Tournament.h"
+#include "Threads.h"
+#include <iomanip>
+#include <iterator>
+
+using std::chrono::duration;
+using std::setprecision;
+using std::fixed;
+
+//  Split the name of a player into its type and the time budget. False if the type is unknown or the budget is not a number
+static bool ParsePlayerName(const string &name, string &type, unsigned int &timeBudget)
+{
+	static const char *types[] = { "random", "minmax", "alphabeta", "montecarloalphabeta", "montecarlo", "mcts" };
+	string::size_type colon = name.find(':');
+
+	type = name.substr(0, colon);
+	timeBudget = 1000;
+	if (colon != string::npos)
+	{
+		string budget = name.substr(colon + 1);
+		if (budget.empty() || budget.find_first_not_of("0123456789") != string::npos)
+			return false;
+		timeBudget = stoul(budget);
+	}
+
+	return std::find(std::begin(types), std::end(types), type) != std::end(types);
+}
+
+bool IsPlayerName(const string &name)
+{
+	string type;
+	unsigned int timeBudget;
+
+	return ParsePlayerName(name, type, timeBudget);
+}
+
+shared_ptr<IPlayer> CreatePlayer(const string &name, PlayerColor playerColor, unsigned int threads /* = 0 */)
+{
+	string type;
+	unsigned int timeBudget;
+
+	if (!ParsePlayerName(name, type, timeBudget))
+		return nullptr;
+
+	if (type == "random")
+		return make_shared<RandomStrategyPlayer>(playerColor);
+	else if (type == "minmax")
+		return make_shared<MinMaxPlayer>(playerColor, timeBudget);
+	else if (type == "alphabeta")
+		return make_shared<AlphaBetaPlayer>(playerColor, timeBudget);
+	else if (type == "montecarloalphabeta")
+		return make_shared<MonteCarloAlphaBetaPlayer>(playerColor, timeBudget);
+	else if (type == "montecarlo")
+		return make_shared<MonteCarloPlayer>(playerColor, threads);
+	else if (type == "mcts")
+		return make_shared<MonteCarloTreeSearchPlayer>(playerColor, timeBudget);
+	else
+		return nullptr;
+}
+
+Tournament::Statistics::Statistics() : m_FirstTurnWins(0), m_Moves(0)
+{
+	m_Wins[0] = m_Wins[1] = 0;
+}
+
+void Tournament::Statistics::Merge(const Statistics &statistics)
+{
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		m_Wins[i] += statistics.m_Wins[i];
+		m_Latencies[i].insert(m_Latencies[i].end(), statistics.m_Latencies[i].begin(), statistics.m_Latencies[i].end());
+	}
+	m_FirstTurnWins += statistics.m_FirstTurnWins;
+	m_Moves += statistics.m_Moves;
+}
+
+Tournament::Tournament(const string &player1, const string &player2, unsigned int size, unsigned int games,
+	unsigned int threads /* = 0 */, HexBoardType boardType /* = BIT_BOARD */) : m_Size(size), m_Games(games), m_Threads(threads),
+	m_BoardType(boardType), m_Seconds(0.0)
+{
+	m_Players[0] = player1;
+	m_Players[1] = player2;
+
+	m_Threads = GetThreadCount(m_Threads);
+	if (m_Threads > m_Games)
+		m_Threads = std::max(1u, m_Games);
+}
+
+Tournament::~Tournament()
+{
+}
+
+void Tournament::PlayGame(unsigned int game, std::mt19937 &random, Statistics &statistics) const
+{
+	//  Players swap colors every game. Parallel games don't share cores with the threads of a player
+	unsigned int first = game % 2;
+	unsigned int playerThreads = m_Threads > 1 ? 1 : 0;
+	shared_ptr<IPlayer> red = CreatePlayer(m_Players[first], RED, playerThreads);
+	shared_ptr<IPlayer> blue = CreatePlayer(m_Players[!first], BLUE, playerThreads);
+	red->SetSeed(random());
+	blue->SetSeed(random());
+	Hex hex(m_Size, red, blue, m_BoardType);
+	PlayerColor winner = NONE;
+
+	while (winner == NONE)
+	{
+		unsigned int player = hex.m_NextPlayer == 1 ? first : !first;
+		steady_clock::time_point start = steady_clock::now();
+
+		winner = hex.MakeTurn(false);
+		statistics.m_Latencies[player].push_back(duration<double, std::milli>(steady_clock::now() - start).count());
+		statistics.m_Moves++;
+	}
+
+	statistics.m_Wins[winner == RED ? first : !first]++;
+	if (winner == RED)
+		statistics.m_FirstTurnWins++;
+}
+
+void Tournament::PlayGames(unsigned int game, unsigned int step, unsigned int seed, Statistics &statistics) const
+{
+	//  rand() of the C library is shared by all the threads, so every worker has its own generator for its players
+	std::mt19937 random(seed);
+	for (; game < m_Games; game += step)
+		PlayGame(game, random, statistics);
+}
+
+bool Tournament::Run()
+{
+	vector<Statistics> statistics(m_Threads);
+	vector<thread> workers;
+	steady_clock::time_point start = steady_clock::now();
+
+	for (unsigned int i = 0; i < 2; ++i)
+		if (!IsPlayerName(m_Players[i]))
+			return false;
+
+	//  Every worker collects its own statistics, they are merged after all the games
+	for (unsigned int t = 1; t < m_Threads; ++t)
+		workers.push_back(thread(&Tournament::PlayGames, this, t, m_Threads, rand(), std::ref(statistics[t])));
+	PlayGames(0, m_Threads, rand(), statistics[0]);
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		it->join();
+
+	m_Seconds = duration<double>(steady_clock::now() - start).count();
+	m_Statistics = Statistics();
+	for (auto it = statistics.begin(); it != statistics.end(); ++it)
+		m_Statistics.Merge(*it);
+	for (unsigned int i = 0; i < 2; ++i)
+		std::sort(m_Statistics.m_Latencies[i].begin(), m_Statistics.m_Latencies[i].end());
+
+	return true;
+}
+
+double Tournament::GetPercentile(const vector<double> &sorted, double percentile)
+{
+	if (sorted.empty())
+		return 0.0;
+
+	//  Nearest rank
+	size_t rank = static_cast<size_t>(ceil(percentile / 100.0 * sorted.size()));
+	return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+double Tournament::GetGamesPerSecond() const
+{
+	return m_Seconds > 0.0 ? m_Games / m_Seconds : 0.0;
+}
+
+double Tournament::GetMovesPerSecond() const
+{
+	return m_Seconds > 0.0 ? m_Statistics.m_Moves / m_Seconds : 0.0;
+}
+
+void Tournament::Report(ostream &os) const
+{
+	const double z = 1.96;
+	unsigned int games = m_Statistics.m_Wins[0] + m_Statistics.m_Wins[1];
+
+	os << m_Players[0] << " vs " << m_Players[1] << ", " << m_Size << "x" << m_Size << ", " << games << " games, "
+		<< m_Threads << " threads\n" << fixed << setprecision(1);
+
+	for (unsigned int i = 0; i < 2 && games > 0; ++i)
+	{
+		//  Wilson score interval keeps the bounds inside [0, 1] even for a small number of games
+		double n = games;
+		double p = m_Statistics.m_Wins[i] / n;
+		double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+		double margin = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+		const vector<double> &latencies = m_Statistics.m_Latencies[i];
+
+		os << m_Players[i] << ": " << m_Statistics.m_Wins[i] << " wins, " << 100 * p << "% [" << 100 * std::max(0.0, center - margin)
+			<< "%, " << 100 * std::min(1.0, center + margin) << "%]\n";
+		os << "  move latency ms: p50 " << GetPercentile(latencies, 50) << ", p90 " << GetPercentile(latencies, 90) << ", p99 "
+			<< GetPercentile(latencies, 99) << ", max " << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+	}
+
+	if (games > 0)
+		os << "first turn wins: " << 100.0 * m_Statistics.m_FirstTurnWins / games << "%\n";
+	os << setprecision(2) << GetGamesPerSecond() << " games/s, " << GetMovesPerSecond() << " moves/s, " << m_Seconds << " s\n";
+}
@@ -0,0 +1,66 @@
+///  Contains the headless tournament runner declaration
+
+#ifndef TOURNAMENT_H__
+#define TOURNAMENT_H__
+
+#include "Hex.h"
+
+//  Create a player by its name: random, minmax, alphabeta, montecarloalphabeta, montecarlo or mcts.
+//  A time budget of the move in milliseconds can follow the name after a colon (for example alphabeta:100),
+//  it is used by minmax, alphabeta, montecarloalphabeta and mcts. threads is the number of threads of the montecarlo player.
+//  Returns nullptr for an unknown name. The human player can't play in a tournament
+shared_ptr<IPlayer> CreatePlayer(const string &name, PlayerColor playerColor, unsigned int threads = 0);
+//  Check if CreatePlayer knows the name, without creating the player
+bool IsPlayerName(const string &name);
+
+//  This class plays a series of games between two players without any output and collects the statistics.
+//  Games run in parallel on m_Threads worker threads, every game has its own players and board.
+//  The players swap colors after every game, so each of them makes the first turn in half of the games
+class Tournament
+{
+private:
+	//  Results of the games played by one worker. Index 0 is the first player, 1 is the second one
+	class Statistics
+	{
+	public:
+		unsigned int m_Wins[2];
+		unsigned int m_FirstTurnWins;
+		unsigned long long m_Moves;
+		//  Time of every move in milliseconds
+		vector<double> m_Latencies[2];
+
+		Statistics();
+		void Merge(const Statistics &statistics);
+	};
+
+	string m_Players[2];
+	unsigned int m_Size;
+	unsigned int m_Games;
+	unsigned int m_Threads;
+	HexBoardType m_BoardType;
+
+	Statistics m_Statistics;
+	double m_Seconds;
+
+	//  Play the game with the given index and add its result to the statistics. The players are seeded from random
+	void PlayGame(unsigned int game, std::mt19937 &random, Statistics &statistics) const;
+	//  Play the games game, game + step, game + 2 * step... It is the body of a worker thread
+	void PlayGames(unsigned int game, unsigned int step, unsigned int seed, Statistics &statistics) const;
+	static double GetPercentile(const vector<double> &sorted, double percentile);
+public:
+	//  threads == 0 means one thread per hardware core
+	Tournament(const string &player1, const string &player2, unsigned int size, unsigned int games, unsigned int threads = 0,
+		HexBoardType boardType = BIT_BOARD);
+	~Tournament();
+
+	//  Play all the games. Returns false if a player name is unknown
+	bool Run();
+	//  Output win rates with 95% Wilson confidence intervals, throughput and move latency percentiles
+	void Report(ostream &os) const;
+
+	unsigned int GetWins(unsigned int player) const { return m_Statistics.m_Wins[player]; }
+	double GetGamesPerSecond() const;
+	double GetMovesPerSecond() const;
+};
+
+#endif
@@ -0,0 +1,91 @@
+///  Contains Zobrist hashing and the transposition table implementation
+#include "TranspositionTable.h"
+
+//  splitmix64 finalizer. Every (cell, color) pair gives a different well mixed 64 bit value
+unsigned long long GetZobristKey(unsigned int cell, PlayerColor playerColor)
+{
+	unsigned long long z = (static_cast<unsigned long long>(cell) * 3 + playerColor + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+TranspositionTable::TranspositionTable(size_t memoryBudget) : m_BucketMask(0), m_Probes(0), m_Hits(0), m_Stores(0), m_Replacements(0)
+{
+	size_t buckets = 1;
+	while (buckets * 2 * BUCKET_SIZE * sizeof(TranspositionEntry) <= memoryBudget)
+		buckets *= 2;
+
+	m_Entries.resize(buckets * BUCKET_SIZE);
+	m_BucketMask = buckets - 1;
+	Clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+}
+
+bool TranspositionTable::Probe(unsigned long long key, TranspositionEntry &entry)
+{
+	const TranspositionEntry *bucket = &m_Entries[(key & m_BucketMask) * BUCKET_SIZE];
+
+	m_Probes++;
+	for (unsigned int i = 0; i < BUCKET_SIZE; ++i)
+		if (bucket[i].m_Bound != NO_BOUND && bucket[i].m_Key == key)
+		{
+			m_Hits++;
+			entry = bucket[i];
+			return true;
+		}
+
+	return false;
+}
+
+void TranspositionTable::Store(unsigned long long key, int value, BoundType bound, unsigned int depth, unsigned short move)
+{
+	TranspositionEntry *bucket = &m_Entries[(key & m_BucketMask) * BUCKET_SIZE];
+	TranspositionEntry *target = nullptr;
+
+	//  The same position is always overwritten, otherwise an empty entry or the shallowest one is taken
+	for (unsigned int i = 0; i < BUCKET_SIZE && !target; ++i)
+		if (bucket[i].m_Bound != NO_BOUND && bucket[i].m_Key == key)
+			target = &bucket[i];
+	for (unsigned int i = 0; i < BUCKET_SIZE && !target; ++i)
+		if (bucket[i].m_Bound == NO_BOUND)
+			target = &bucket[i];
+	if (!target)
+	{
+		target = &bucket[0];
+		for (unsigned int i = 1; i < BUCKET_SIZE; ++i)
+			if (bucket[i].m_Depth < target->m_Depth)
+				target = &bucket[i];
+		m_Replacements++;
+	}
+
+	m_Stores++;
+	target->m_Key = key;
+	target->m_Value = value;
+	target->m_Move = move;
+	target->m_Depth = depth > 255 ? 255 : depth;
+	target->m_Bound = bound;
+}
+
+void TranspositionTable::Clear()
+{
+	for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+	{
+		it->m_Key = 0;
+		it->m_Value = 0;
+		it->m_Move = TranspositionEntry::NO_MOVE;
+		it->m_Depth = 0;
+		it->m_Bound = NO_BOUND;
+	}
+}
+
+void TranspositionTable::ResetStatistics()
+{
+	m_Probes = 0;
+	m_Hits = 0;
+	m_Stores = 0;
+	m_Replacements = 0;
+}
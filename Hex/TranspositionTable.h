@@ -0,0 +1,69 @@
+///  Contains Zobrist hashing and the transposition table declaration
+
+#ifndef TRANSPOSITION_TABLE_H__
+#define TRANSPOSITION_TABLE_H__
+
+#include "Graph.h"
+#include <cstddef>
+
+//  Get the Zobrist key of a stone of the given color on the given cell.
+//  The hash of a board is the XOR of the keys of all its stones, so it is updated incrementally when a stone
+//  is placed or taken back. Keys are produced by a fixed mixing function, so there is no limit of the board size
+unsigned long long GetZobristKey(unsigned int cell, PlayerColor playerColor);
+
+//  What the stored value means for the alpha-beta search. NO_BOUND marks an empty entry
+enum BoundType{NO_BOUND, EXACT_BOUND, LOWER_BOUND, UPPER_BOUND};
+
+//  One entry of the table. It is 16 bytes, so a bucket of 4 entries fits a cache line
+class TranspositionEntry
+{
+public:
+	static const unsigned short NO_MOVE = 0xFFFF;
+
+	unsigned long long m_Key;
+	int m_Value;
+	//  Best move as the vertex number of the field, NO_MOVE if there is none
+	unsigned short m_Move;
+	unsigned char m_Depth;
+	unsigned char m_Bound;
+};
+
+//  This class implements a fixed-size transposition table. The memory budget is given in bytes
+//  and rounded down to a power of 2 number of buckets. A position is stored in the bucket chosen by
+//  the low bits of its hash. If the bucket is full the entry with the smallest depth is replaced
+class TranspositionTable
+{
+public:
+	static const unsigned int BUCKET_SIZE = 4;
+private:
+	vector<TranspositionEntry> m_Entries;
+	size_t m_BucketMask;
+
+	//  Statistics
+	unsigned long long m_Probes;
+	unsigned long long m_Hits;
+	unsigned long long m_Stores;
+	unsigned long long m_Replacements;
+public:
+	explicit TranspositionTable(size_t memoryBudget);
+	~TranspositionTable();
+
+	//  Find the entry of the position. Returns false if the position is not in the table
+	bool Probe(unsigned long long key, TranspositionEntry &entry);
+	//  Store the result of a search of the position
+	void Store(unsigned long long key, int value, BoundType bound, unsigned int depth, unsigned short move);
+	//  Remove all the entries. Statistics are not reset
+	void Clear();
+
+	//  Get the memory used by the entries in bytes
+	size_t GetMemoryUsage() const { return m_Entries.size() * sizeof(TranspositionEntry); }
+	unsigned long long GetProbes() const { return m_Probes; }
+	unsigned long long GetHits() const { return m_Hits; }
+	unsigned long long GetMisses() const { return m_Probes - m_Hits; }
+	unsigned long long GetStores() const { return m_Stores; }
+	//  Number of stores that overwrote an entry of another position
+	unsigned long long GetReplacements() const { return m_Replacements; }
+	void ResetStatistics();
+};
+
+#endif
@@ -1,8 +1,36 @@
 #include "Hex.h"
+#include "Tournament.h"
 
-int main()
+//  Without arguments a human plays against the computer.
+//  Hex <player1> <player2> <size> <games> [threads] plays a tournament between two engines (see CreatePlayer)
+int main(int argc, char *argv[])
 {
-	Hex hex(11);
+	srand(time(NULL));
+
+	if (argc > 1)
+	{
+		unsigned int size = argc >= 5 ? atoi(argv[3]) : 0;
+		unsigned int games = argc >= 5 ? atoi(argv[4]) : 0;
+
+		if (argc > 6 || size < 2 || games == 0)
+		{
+			cout << "Usage: Hex <player1> <player2> <size> <games> [threads]\n"
+				"Players: random, minmax, alphabeta, montecarloalphabeta, montecarlo, mcts\n"
+				"A move time budget in milliseconds can follow a name, for example alphabeta:100\n";
+			return 1;
+		}
+
+		Tournament tournament(argv[1], argv[2], size, games, argc == 6 ? atoi(argv[5]) : 0);
+		if (!tournament.Run())
+		{
+			cout << "Unknown player\n";
+			return 1;
+		}
+		tournament.Report(cout);
+		return 0;
+	}
+
+	Hex hex(11, BIT_BOARD);
 
 
 	PlayerColor winner = hex.Play();
@@ -16,4 +44,4 @@ int main()
 	cin.get();
 	cin.get();
 	return 0;
-}
\ No newline at end of file
+}